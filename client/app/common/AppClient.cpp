@@ -212,12 +212,12 @@ AppClient::AppClient(boost::asio::io_context& io, int& result) :
     m_client(::cc_mqttsn_client_alloc())
 {
     assert(m_client);
-    ::cc_mqttsn_client_set_send_output_data_callback(m_client.get(), &AppClient::sendDataCb, this);
+    ::cc_mqttsn_client_set_output_buffer_callbacks(m_client.get(), &AppClient::getOutputBufferCb, &AppClient::commitOutputBufferCb, this);
     ::cc_mqttsn_client_set_gw_disconnect_report_callback(m_client.get(), &AppClient::gwDisconnectedReportCb, this);
     ::cc_mqttsn_client_set_message_report_callback(m_client.get(), &AppClient::messageReceivedCb, this);
     ::cc_mqttsn_client_set_error_log_callback(m_client.get(), &AppClient::logMessageCb, this);
     ::cc_mqttsn_client_set_next_tick_program_callback(m_client.get(), &AppClient::nextTickProgramCb, this);
-    ::cc_mqttsn_client_set_cancel_next_tick_wait_callback(m_client.get(), &AppClient::cancelNextTickWaitCb, this);
+    ::cc_mqttsn_client_set_clock_callback(m_client.get(), &AppClient::clockCb, this);
 }
 
 std::ostream& AppClient::logError()
@@ -432,10 +432,10 @@ std::string AppClient::toString(CC_MqttsnReturnCode val)
 
 void AppClient::nextTickProgramInternal(unsigned duration)
 {
-    m_lastWaitProgram = Clock::now();
+    // Re-programming replaces (cancels) the previous wait
     m_timer.expires_after(std::chrono::milliseconds(duration));
     m_timer.async_wait(
-        [this, duration](const boost::system::error_code& ec)
+        [this](const boost::system::error_code& ec)
         {
             if (ec == boost::asio::error::operation_aborted) {
                 return;
@@ -447,32 +447,35 @@ void AppClient::nextTickProgramInternal(unsigned duration)
                 return;
             }
 
-            ::cc_mqttsn_client_tick(m_client.get(), duration);
+            // The elapsed time is measured by the library using the clock
+            ::cc_mqttsn_client_tick(m_client.get(), 0U);
         }
     );
 }
 
-unsigned AppClient::cancelNextTickWaitInternal()
+unsigned long long AppClient::clockInternal() const
 {
-    m_timer.cancel();
-    auto now = Clock::now();
-    auto diff = std::chrono::duration_cast<std::chrono::milliseconds>(now - m_lastWaitProgram).count();
-    return static_cast<unsigned>(diff);
+    auto sinceEpoch = Clock::now().time_since_epoch();
+    return static_cast<unsigned long long>(std::chrono::duration_cast<std::chrono::milliseconds>(sinceEpoch).count());
 }
 
-void AppClient::sendDataInternal(const unsigned char* buf, unsigned bufLen, unsigned broadcastRadius)
+unsigned char* AppClient::getOutputBufferInternal(unsigned bufLen)
+{
+    // Serialize directly after the forwarder encapsulation prefix (if any)
+    m_outBuf.assign(m_fwdEncPrefix.begin(), m_fwdEncPrefix.end());
+    m_outBuf.resize(m_fwdEncPrefix.size() + bufLen);
+    return &m_outBuf[m_fwdEncPrefix.size()];
+}
+
+void AppClient::commitOutputBufferInternal(unsigned bufLen, unsigned broadcastRadius)
 {
     assert(m_session);
-    if (m_fwdEncPrefix.empty()) {
-        m_session->sendData(buf, bufLen, broadcastRadius);
+    if (bufLen == 0U) {
         return;
     }
 
-    std::vector<std::uint8_t> encData;
-    encData.reserve(m_fwdEncPrefix.size() + bufLen);
-    encData.insert(encData.end(), m_fwdEncPrefix.begin(), m_fwdEncPrefix.end());
-    encData.insert(encData.end(), buf, buf + bufLen);
-    m_session->sendData(encData.data(), encData.size(), broadcastRadius);
+    assert((m_fwdEncPrefix.size() + bufLen) <= m_outBuf.size());
+    m_session->sendData(m_outBuf.data(), m_fwdEncPrefix.size() + bufLen, broadcastRadius);
 }
 
 bool AppClient::createSession()
@@ -573,9 +576,14 @@ void AppClient::gwDisconnectedReportInternal(CC_MqttsnGatewayDisconnectReason re
     gwDisconnectedReportImpl();
 }
 
-void AppClient::sendDataCb(void* data, const unsigned char* buf, unsigned bufLen, unsigned broadcastRadius)
+unsigned char* AppClient::getOutputBufferCb(void* data, unsigned bufLen)
+{
+    return asThis(data)->getOutputBufferInternal(bufLen);
+}
+
+void AppClient::commitOutputBufferCb(void* data, [[maybe_unused]] unsigned char* buf, unsigned bufLen, unsigned broadcastRadius)
 {
-    asThis(data)->sendDataInternal(buf, bufLen, broadcastRadius);
+    asThis(data)->commitOutputBufferInternal(bufLen, broadcastRadius);
 }
 
 void AppClient::messageReceivedCb(void* data, const CC_MqttsnMessageInfo* info)
@@ -593,9 +601,9 @@ void AppClient::nextTickProgramCb(void* data, unsigned duration)
     asThis(data)->nextTickProgramInternal(duration);
 }
 
-unsigned AppClient::cancelNextTickWaitCb(void* data)
+unsigned long long AppClient::clockCb(void* data)
 {
-    return asThis(data)->cancelNextTickWaitInternal();
+    return asThis(data)->clockInternal();
 }
 
 void AppClient::connectCompleteCb(void* data, CC_MqttsnAsyncOpStatus status, const CC_MqttsnConnectInfo* info)
@@ -89,21 +89,22 @@ protected:
 private:
     using ClientPtr = std::unique_ptr<CC_MqttsnClient, ClientDeleter>;
     using Clock = Timer::clock_type;
-    using Timestamp = Timer::time_point;
 
     void nextTickProgramInternal(unsigned duration);
-    unsigned cancelNextTickWaitInternal();
-    void sendDataInternal(const unsigned char* buf, unsigned bufLen, unsigned broadcastRadius);
+    unsigned long long clockInternal() const;
+    unsigned char* getOutputBufferInternal(unsigned bufLen);
+    void commitOutputBufferInternal(unsigned bufLen, unsigned broadcastRadius);
     bool createSession();
     void connectCompleteInternal(CC_MqttsnAsyncOpStatus status, const CC_MqttsnConnectInfo* info);
     void disconnectCompleteInternal(CC_MqttsnAsyncOpStatus status);
     void gwDisconnectedReportInternal(CC_MqttsnGatewayDisconnectReason reason);
 
-    static void sendDataCb(void* data, const unsigned char* buf, unsigned bufLen, unsigned broadcastRadius);
+    static unsigned char* getOutputBufferCb(void* data, unsigned bufLen);
+    static void commitOutputBufferCb(void* data, unsigned char* buf, unsigned bufLen, unsigned broadcastRadius);
     static void messageReceivedCb(void* data, const CC_MqttsnMessageInfo* info);
     static void logMessageCb(void* data, const char* msg);
     static void nextTickProgramCb(void* data, unsigned duration);
-    static unsigned cancelNextTickWaitCb(void* data);
+    static unsigned long long clockCb(void* data);
     static void connectCompleteCb(void* data, CC_MqttsnAsyncOpStatus status, const CC_MqttsnConnectInfo* info);
     static void disconnectCompleteCb(void* data, CC_MqttsnAsyncOpStatus status);
     static void gwDisconnectedReportCb(void* data, CC_MqttsnGatewayDisconnectReason reason);
@@ -111,11 +112,11 @@ private:
     boost::asio::io_context& m_io;
     int& m_result;
     Timer m_timer;
-    Timestamp m_lastWaitProgram;
     ProgramOptions m_opts;
     ClientPtr m_client;
     SessionPtr m_session;
     std::vector<std::uint8_t> m_fwdEncPrefix;
+    std::vector<std::uint8_t> m_outBuf;
     Addr m_lastAddr;
 };
 
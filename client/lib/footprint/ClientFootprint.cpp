@@ -0,0 +1,151 @@
+//
+// Copyright 2026 - 2026 (C). Alex Robenko. All rights reserved.
+//
+// SPDX-License-Identifier: MPL-2.0
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+// Reports the RAM footprint of the client library built with the custom configuration.
+// All the values are computed at compile time, the application only prints them.
+
+#include "ClientImpl.h"
+#include "ExtConfig.h"
+#include "ObjAllocator.h"
+#include "ObjListType.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <type_traits>
+
+namespace
+{
+
+using namespace cc_mqttsn_client;
+
+struct Entry
+{
+    const char* m_name = nullptr;
+    std::size_t m_size = 0U; // Size of a single element
+    unsigned m_count = 0U; // Number of statically allocated elements, 0 means dynamic
+    std::size_t m_storage = 0U; // Bytes contained in the ClientImpl object
+};
+
+template <typename TOp, unsigned TLimit>
+constexpr Entry opEntry(const char* name)
+{
+    return Entry{name, sizeof(TOp), TLimit, sizeof(ObjAllocator<TOp, TLimit>) + sizeof(ObjListType<typename ObjAllocator<TOp, TLimit>::Ptr, TLimit>)};
+}
+
+// The empty classes are used as base classes and occupy no space
+template <typename T>
+constexpr std::size_t objSize()
+{
+    return std::is_empty<T>::value ? 0U : sizeof(T);
+}
+
+template <typename T, unsigned TLimit>
+constexpr Entry allocEntry(const char* name)
+{
+    return Entry{name, sizeof(T), TLimit, sizeof(ObjAllocator<T, TLimit>)};
+}
+
+template <typename T>
+constexpr Entry objEntry(const char* name, unsigned count = 1U)
+{
+    return Entry{name, objSize<T>(), count, objSize<T>()};
+}
+
+template <typename T, unsigned TLimit>
+constexpr Entry listEntry(const char* name)
+{
+    return Entry{name, sizeof(T), TLimit, sizeof(ObjListType<T, TLimit>)};
+}
+
+constexpr Entry OpsEntries[] = {
+#if CC_MQTTSN_CLIENT_HAS_GATEWAY_DISCOVERY
+    opEntry<op::SearchOp, ExtConfig::SearchOpsLimit>("SearchOp"),
+#endif // #if CC_MQTTSN_CLIENT_HAS_GATEWAY_DISCOVERY
+    opEntry<op::ConnectOp, ExtConfig::ConnectOpsLimit>("ConnectOp"),
+    opEntry<op::KeepAliveOp, ExtConfig::KeepAliveOpsLimit>("KeepAliveOp"),
+    opEntry<op::DisconnectOp, ExtConfig::DisconnectOpsLimit>("DisconnectOp"),
+    opEntry<op::SubscribeOp, ExtConfig::SubscribeOpsLimit>("SubscribeOp"),
+    opEntry<op::UnsubscribeOp, ExtConfig::UnsubscribeOpsLimit>("UnsubscribeOp"),
+    opEntry<op::SendOp, ExtConfig::SendOpsLimit>("SendOp"),
+    allocEntry<op::SendOpStorage, ExtConfig::SendOpStoragesLimit>("SendOpStorage"),
+#if CC_MQTTSN_CLIENT_HAS_WILL
+    opEntry<op::WillOp, ExtConfig::WillOpsLimit>("WillOp"),
+#endif // #if CC_MQTTSN_CLIENT_HAS_WILL
+};
+
+constexpr Entry StateEntries[] = {
+    objEntry<TimerMgr>("TimerMgr (timers)", ExtConfig::TimersLimit),
+    objEntry<InRegTopicsMap>("InRegTopicsMap", Config::InRegTopicsLimit),
+    objEntry<OutRegTopicsMap>("OutRegTopicsMap", Config::OutRegTopicsLimit),
+    objEntry<SubFilters>("SubFilters", Config::SubFiltersLimit),
+    objEntry<ReuseState>("ReuseState (total)"),
+    objEntry<ClientState>("ClientState"),
+    objEntry<SessionState>("SessionState"),
+    objEntry<ConfigState>("ConfigState"),
+    objEntry<ClientStats>("ClientStats"),
+    listEntry<std::uint8_t, ExtConfig::MaxOutputPacketSize>("OutputBuf"),
+    objEntry<ProtFrame>("ProtFrame"),
+    objEntry<RxRing>("RxRing", ExtConfig::RxRingFrames),
+};
+
+constexpr std::size_t ClientSize = sizeof(ClientImpl);
+constexpr unsigned ClientsCount = Config::ClientAllocLimit;
+
+void printHeader(const char* title)
+{
+    std::cout << '\n' << title << '\n' <<
+        std::left << std::setw(24) << "Item" <<
+        std::right << std::setw(12) << "Elem size" <<
+        std::setw(8) << "Count" <<
+        std::setw(12) << "In client" << '\n';
+}
+
+void printEntry(const Entry& entry)
+{
+    std::cout <<
+        std::left << std::setw(24) << entry.m_name <<
+        std::right << std::setw(12) << entry.m_size;
+
+    if (entry.m_count == 0U) {
+        std::cout << std::setw(8) << "dyn";
+    }
+    else {
+        std::cout << std::setw(8) << entry.m_count;
+    }
+
+    std::cout << std::setw(12) << entry.m_storage << '\n';
+}
+
+} // namespace
+
+int main()
+{
+    std::cout << "Memory footprint of " << CC_MQTTSN_CLIENT_FOOTPRINT_LIB_NAME << '\n';
+    std::cout << "sizeof(ClientImpl): " << ClientSize << '\n';
+    if (ClientsCount == 0U) {
+        std::cout << "Clients: allocated dynamically\n";
+    }
+    else {
+        std::cout << "Clients: " << ClientsCount << " (static RAM: " << (ClientSize * ClientsCount) << ")\n";
+    }
+
+    printHeader("Operations (in client: allocator + list of pointers):");
+    for (auto& entry : OpsEntries) {
+        printEntry(entry);
+    }
+
+    printHeader("Internal state:");
+    for (auto& entry : StateEntries) {
+        printEntry(entry);
+    }
+
+    return 0;
+}
@@ -0,0 +1,275 @@
+//
+// Copyright 2026 - 2026 (C). Alex Robenko. All rights reserved.
+//
+// SPDX-License-Identifier: MPL-2.0
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+/// @file
+/// @brief Optional thread-safe producer queue in front of the single-threaded client.
+
+#pragma once
+
+#include "cc_mqttsn_client/common.h"
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace cc_mqttsn_client
+{
+
+/// @brief Thread-safe queue of the "publish" requests.
+/// @details The client library is single-threaded, all its API functions must be
+///     invoked from the same (event loop) thread. This class allows multiple producer
+///     threads to enqueue "publish" requests using a lock-free intrusive MPSC queue.
+///     The event loop thread periodically calls @ref drain() to initiate the queued
+///     publishes in batches using single @b cc_mqttsn_client_publish_batch() call.
+///     The results are pushed into another lock-free MPSC queue and are expected
+///     to be consumed by a single thread using @ref popCompletion().
+/// @note The client must be freed before the queue object is destructed.
+/// @headerfile "cc_mqttsn_client/ProducerQueue.h"
+class ProducerQueue
+{
+public:
+    /// @brief Type of the @b cc_mqttsn_client_publish_batch() function of the used client variant.
+    using PublishBatchFunc = unsigned (*)(CC_MqttsnClientHandle, CC_MqttsnPublishRequest*, unsigned);
+
+    /// @brief Default maximal number of requests initiated by single @ref drain() call.
+    static constexpr unsigned DefaultBatchSize = 16U;
+
+    /// @brief Completion report of the queued "publish" request.
+    struct Completion
+    {
+        std::uint64_t m_token = 0U; ///< Token provided to the @ref publish() call.
+        CC_MqttsnErrorCode m_ec = CC_MqttsnErrorCode_Success; ///< Result of the operation initiation.
+        CC_MqttsnAsyncOpStatus m_status = CC_MqttsnAsyncOpStatus_Complete; ///< Status of the operation, relevant only when @b m_ec is @ref CC_MqttsnErrorCode_Success.
+        CC_MqttsnReturnCode m_returnCode = CC_MqttsnReturnCode_Accepted; ///< Return code reported by the gateway, relevant only when @b m_status is @ref CC_MqttsnAsyncOpStatus_Complete.
+    };
+
+    /// @brief Constructor
+    /// @param[in] client Handle of the allocated client.
+    /// @param[in] func Pointer to the @b cc_mqttsn_client_publish_batch() function of the relevant client variant.
+    ProducerQueue(CC_MqttsnClientHandle client, PublishBatchFunc func) :
+        m_client(client),
+        m_publishBatchFunc(func)
+    {
+    }
+
+    ProducerQueue(const ProducerQueue&) = delete;
+    ProducerQueue& operator=(const ProducerQueue&) = delete;
+
+    /// @brief Destructor
+    /// @details Releases all the requests and completion reports that haven't been consumed.
+    ~ProducerQueue()
+    {
+        clearQueue(m_requests);
+        clearQueue(m_completions);
+    }
+
+    /// @brief Enqueue "publish" request with the topic name.
+    /// @details Can be invoked from any thread.
+    /// @param[in] topic Publish topic, the ownership is transferred to the queue.
+    /// @param[in] data Publish data, the ownership is transferred to the queue.
+    /// @param[in] qos Publish QoS.
+    /// @param[in] retain Publish retain flag.
+    /// @param[in] token Application specific token reported back in the @ref Completion.
+    void publish(std::string topic, std::vector<std::uint8_t> data, CC_MqttsnQoS qos, bool retain = false, std::uint64_t token = 0U)
+    {
+        auto* node = new Node;
+        node->m_topic = std::move(topic);
+        node->m_data = std::move(data);
+        node->m_qos = qos;
+        node->m_retain = retain;
+        node->m_completion.m_token = token;
+        m_requests.push(node);
+    }
+
+    /// @brief Enqueue "publish" request with the pre-defined topic ID.
+    /// @details Can be invoked from any thread.
+    /// @param[in] topicId Pre-defined topic ID.
+    /// @param[in] data Publish data, the ownership is transferred to the queue.
+    /// @param[in] qos Publish QoS.
+    /// @param[in] retain Publish retain flag.
+    /// @param[in] token Application specific token reported back in the @ref Completion.
+    void publish(CC_MqttsnTopicId topicId, std::vector<std::uint8_t> data, CC_MqttsnQoS qos, bool retain = false, std::uint64_t token = 0U)
+    {
+        auto* node = new Node;
+        node->m_topicId = topicId;
+        node->m_data = std::move(data);
+        node->m_qos = qos;
+        node->m_retain = retain;
+        node->m_completion.m_token = token;
+        m_requests.push(node);
+    }
+
+    /// @brief Initiate the queued "publish" requests.
+    /// @details Must be invoked from the thread that owns the client. The requests
+    ///     which failed to be initiated are reported via the completion queue right away.
+    /// @param[in] maxBatch Maximal number of requests to initiate.
+    /// @return Number of the processed requests.
+    unsigned drain(unsigned maxBatch = DefaultBatchSize)
+    {
+        m_batch.clear();
+        while (m_batch.size() < maxBatch) {
+            auto* node = m_requests.pop();
+            if (node == nullptr) {
+                break;
+            }
+
+            auto req = CC_MqttsnPublishRequest();
+            auto& config = req.m_config;
+            config.m_topic = node->m_topic.empty() ? nullptr : node->m_topic.c_str();
+            config.m_data = node->m_data.data();
+            config.m_dataLen = static_cast<unsigned>(node->m_data.size());
+            config.m_topicId = node->m_topicId;
+            config.m_qos = node->m_qos;
+            config.m_retain = node->m_retain;
+            req.m_cb = &ProducerQueue::publishCompleteCb;
+            req.m_cbData = node;
+            node->m_owner = this;
+            m_batch.push_back(req);
+        }
+
+        if (m_batch.empty()) {
+            return 0U;
+        }
+
+        auto count = static_cast<unsigned>(m_batch.size());
+        auto failures = m_publishBatchFunc(m_client, m_batch.data(), count);
+        for (auto idx = 0U; (idx < count) && (0U < failures); ++idx) {
+            auto& req = m_batch[idx];
+            if (req.m_ec == CC_MqttsnErrorCode_Success) {
+                continue;
+            }
+
+            auto* node = static_cast<Node*>(req.m_cbData);
+            node->m_completion.m_ec = req.m_ec;
+            reportCompletion(node);
+            --failures;
+        }
+
+        return count;
+    }
+
+    /// @brief Retrieve the next completion report.
+    /// @details Must be invoked from a single consumer thread at a time.
+    /// @param[out] completion Completion report.
+    /// @return @b true when the report has been retrieved, @b false when the queue is empty.
+    bool popCompletion(Completion& completion)
+    {
+        auto* node = m_completions.pop();
+        if (node == nullptr) {
+            return false;
+        }
+
+        completion = node->m_completion;
+        delete node;
+        return true;
+    }
+
+private:
+    struct Node
+    {
+        std::atomic<Node*> m_next{nullptr};
+        ProducerQueue* m_owner = nullptr;
+        std::string m_topic;
+        std::vector<std::uint8_t> m_data;
+        CC_MqttsnTopicId m_topicId = 0U;
+        CC_MqttsnQoS m_qos = CC_MqttsnQoS_AtMostOnceDelivery;
+        bool m_retain = false;
+        Completion m_completion;
+    };
+
+    // Intrusive multi-producer single-consumer queue (Vyukov), the
+    // producers never block each other nor the consumer.
+    class MpscQueue
+    {
+    public:
+        MpscQueue() : m_head(&m_stub), m_tail(&m_stub) {}
+
+        void push(Node* node)
+        {
+            node->m_next.store(nullptr, std::memory_order_relaxed);
+            auto* prev = m_head.exchange(node, std::memory_order_acq_rel);
+            prev->m_next.store(node, std::memory_order_release);
+        }
+
+        Node* pop()
+        {
+            auto* tail = m_tail;
+            auto* next = tail->m_next.load(std::memory_order_acquire);
+            if (tail == &m_stub) {
+                if (next == nullptr) {
+                    return nullptr;
+                }
+
+                m_tail = next;
+                tail = next;
+                next = next->m_next.load(std::memory_order_acquire);
+            }
+
+            if (next != nullptr) {
+                m_tail = next;
+                return tail;
+            }
+
+            if (tail != m_head.load(std::memory_order_acquire)) {
+                // The producer is in the middle of the push, retry later
+                return nullptr;
+            }
+
+            push(&m_stub);
+            next = tail->m_next.load(std::memory_order_acquire);
+            if (next == nullptr) {
+                return nullptr;
+            }
+
+            m_tail = next;
+            return tail;
+        }
+
+    private:
+        std::atomic<Node*> m_head;
+        Node* m_tail = nullptr;
+        Node m_stub;
+    };
+
+    static void clearQueue(MpscQueue& queue)
+    {
+        while (auto* node = queue.pop()) {
+            delete node;
+        }
+    }
+
+    void reportCompletion(Node* node)
+    {
+        // The payload has been copied by the client, release it right away
+        node->m_topic = std::string();
+        node->m_data = std::vector<std::uint8_t>();
+        m_completions.push(node);
+    }
+
+    static void publishCompleteCb(void* data, [[maybe_unused]] CC_MqttsnPublishHandle handle, CC_MqttsnAsyncOpStatus status, const CC_MqttsnPublishInfo* info)
+    {
+        auto* node = static_cast<Node*>(data);
+        node->m_completion.m_status = status;
+        if (info != nullptr) {
+            node->m_completion.m_returnCode = info->m_returnCode;
+        }
+
+        node->m_owner->reportCompletion(node);
+    }
+
+    CC_MqttsnClientHandle m_client = nullptr;
+    PublishBatchFunc m_publishBatchFunc = nullptr;
+    MpscQueue m_requests;
+    MpscQueue m_completions;
+    std::vector<CC_MqttsnPublishRequest> m_batch;
+};
+
+} // namespace cc_mqttsn_client
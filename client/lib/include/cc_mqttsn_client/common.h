@@ -137,6 +137,21 @@ typedef enum
     CC_MqttsnDataOrigin_ValuesLimit ///< Limit for the values
 } CC_MqttsnDataOrigin;
 
+/// @brief Type of the operation, used as an index in @ref CC_MqttsnClientStats::m_ops
+/// @ingroup global
+typedef enum
+{
+    CC_MqttsnOpType_Search = 0, ///< The "search" operation
+    CC_MqttsnOpType_Connect = 1, ///< The "connect" operation
+    CC_MqttsnOpType_KeepAlive = 2, ///< Internal "keep alive" operation
+    CC_MqttsnOpType_Disconnect = 3, ///< The "disconnect" and "sleep" operations
+    CC_MqttsnOpType_Subscribe = 4, ///< The "subscribe" operation
+    CC_MqttsnOpType_Unsubscribe = 5, ///< The "unsubscribe" operation
+    CC_MqttsnOpType_Publish = 6, ///< The "publish" operation
+    CC_MqttsnOpType_Will = 7, ///< The "will" update operation
+    CC_MqttsnOpType_ValuesLimit ///< Limit for the values
+} CC_MqttsnOpType;
+
 /// @brief Declaration of struct for the @ref CC_MqttsnClientHandle;
 /// @ingroup client
 struct CC_MqttsnClient;
@@ -307,6 +322,20 @@ typedef struct
     bool m_retain; ///< Publish message retain configuration.
 } CC_MqttsnPublishConfig;
 
+/// @brief Topic prepared for the repeated "publish" operations
+/// @details Initialized by the @b cc_mqttsn_client_prepare_topic() function and used by
+///     the @b cc_mqttsn_client_publish_config_prepared() one. The members are managed by the library
+///     and must not be modified by the application.
+/// @ingroup publish
+typedef struct
+{
+    const char* m_topic; ///< Publish topic, the string must be preserved while the prepared topic is in use.
+    const void* m_client; ///< Client the topic has been prepared for.
+    CC_MqttsnTopicId m_topicId; ///< Cached topic ID, @b 0 when not known yet.
+    unsigned m_topicIdType; ///< Cached type of the topic ID.
+    unsigned m_generation; ///< Generation of the topic registration the cached topic ID belongs to.
+} CC_MqttsnPreparedTopic;
+
 /// @brief Information on the "publish" operation completion
 /// @ingroup publish
 typedef struct
@@ -329,6 +358,58 @@ typedef struct
     unsigned m_duration; ///< Duration configuration in seconds.
 } CC_MqttsnSleepConfig;
 
+/// @brief Single segment of the output data.
+/// @ingroup client
+typedef struct
+{
+    const unsigned char* m_data; ///< Pointer to the segment data.
+    unsigned m_dataLen; ///< Number of bytes in the segment.
+} CC_MqttsnOutputSegment;
+
+/// @brief Single datagram of the input data for the batch processing.
+/// @see cc_mqttsn_client_process_data_batch()
+/// @ingroup client
+typedef struct
+{
+    const unsigned char* m_buf; ///< Pointer to the buffer of the received datagram.
+    unsigned m_bufLen; ///< Number of bytes in the buffer.
+    CC_MqttsnDataOrigin m_origin; ///< Origin of the data.
+    bool m_decodeFailure; ///< Output: set by the library when the datagram failed to be decoded.
+} CC_MqttsnInputData;
+
+/// @brief Number of the message types tracked in the @ref CC_MqttsnClientStats.
+/// @details The MQTT-SN message type (@b MsgType field) is used as an index.
+/// @ingroup client
+#define CC_MQTTSN_CLIENT_STATS_MSG_TYPES_LIMIT 0x1eU
+
+/// @brief Statistics of the single operation type
+/// @see @ref CC_MqttsnClientStats
+/// @ingroup client
+typedef struct
+{
+    unsigned long long m_completed; ///< Number of completed operations.
+    unsigned long long m_retries; ///< Number of message re-transmissions.
+    unsigned long long m_timeouts; ///< Number of operations terminated due to lack of the response.
+    unsigned long long m_latencyTotalMs; ///< Sum of all the completion latencies in milliseconds, used to calculate average.
+    unsigned m_latencyMinMs; ///< Minimal completion latency in milliseconds.
+    unsigned m_latencyMaxMs; ///< Maximal completion latency in milliseconds.
+} CC_MqttsnOpStats;
+
+/// @brief Runtime statistics of the client
+/// @see @ref cc_mqttsn_client_get_stats()
+/// @ingroup client
+typedef struct
+{
+    unsigned long long m_sentMsgs[CC_MQTTSN_CLIENT_STATS_MSG_TYPES_LIMIT]; ///< Number of sent messages per message type.
+    unsigned long long m_receivedMsgs[CC_MQTTSN_CLIENT_STATS_MSG_TYPES_LIMIT]; ///< Number of received messages per message type.
+    unsigned long long m_sentBytes; ///< Total number of sent bytes.
+    unsigned long long m_receivedBytes; ///< Total number of received bytes, including the ones that failed decoding.
+    unsigned long long m_decodeFailures; ///< Number of received datagrams which failed to be decoded.
+    unsigned long long m_droppedUnsubscribed; ///< Number of received application messages dropped due to not being subscribed.
+    CC_MqttsnOpStats m_ops[CC_MqttsnOpType_ValuesLimit]; ///< Statistics per operation type.
+    unsigned m_opsCount; ///< Number of currently active operations.
+} CC_MqttsnClientStats;
+
 /// @brief Callback used to request time measurement.
 /// @details The callback is set using
 ///     cc_mqttsn_client_set_next_tick_program_callback() function.
@@ -348,6 +429,17 @@ typedef void (*CC_MqttsnNextTickProgramCb)(void* data, unsigned duration);
 /// @ingroup client
 typedef unsigned (*CC_MqttsnCancelNextTickWaitCb)(void* data);
 
+/// @brief Callback used to retrieve current time of a monotonic clock.
+/// @details The callback is set using
+///     cc_mqttsn_client_set_clock_callback() function.
+/// @param[in] data Pointer to user data object, passed as last parameter to
+///     cc_mqttsn_client_set_clock_callback() function.
+/// @return Current time in @b milliseconds. Only the difference between
+///     two consecutive readings is used, i.e. the starting point of the clock
+///     can be arbitrary, but the reported values must never decrease.
+/// @ingroup client
+typedef unsigned long long (*CC_MqttsnClockCb)(void* data);
+
 /// @brief Callback used to request to send data to the gateway.
 /// @details The callback is set using
 ///     cc_mqttsn_client_set_send_output_data_callback() function. The reported
@@ -363,6 +455,52 @@ typedef unsigned (*CC_MqttsnCancelNextTickWaitCb)(void* data);
 /// @ingroup client
 typedef void (*CC_MqttsnSendOutputDataCb)(void* data, const unsigned char* buf, unsigned bufLen, unsigned broadcastRadius);
 
+/// @brief Callback used to request to send data to the gateway split into several segments.
+/// @details The callback is set using
+///     cc_mqttsn_client_set_send_output_segments_callback() function. When set,
+///     it is used instead of the callback set by cc_mqttsn_client_set_send_output_data_callback()
+///     to send all the messages. The messages which reference the data lent by the application
+///     (see cc_mqttsn_client_publish_config_zero_copy()) are reported as two segments: the
+///     serialized header and the lent data. All other messages are reported as a single segment.
+///     All the segments belong to a single message and
+///     need to be sent as a single datagram in the reported order. The reported
+///     segments are valid only until the callback function returns.
+/// @param[in] data Pointer to user data object, passed as last parameter to
+///     cc_mqttsn_client_set_send_output_segments_callback() function.
+/// @param[in] segments Pointer to the array of the segments to send
+/// @param[in] count Number of the segments in the array
+/// @param[in] broadcastRadius Broadcast radius. When @b 0, means unicast to the connected gateway.
+/// @ingroup client
+typedef void (*CC_MqttsnSendOutputSegmentsCb)(void* data, const CC_MqttsnOutputSegment* segments, unsigned count, unsigned broadcastRadius);
+
+/// @brief Callback used to request the output buffer to serialize the message into.
+/// @details The callback is set using
+///     cc_mqttsn_client_set_output_buffer_callbacks() function. It allows
+///     serialization of the output message directly into the memory of the I/O link
+///     (such as DMA buffer) without any intermediate copies. Every successfully
+///     provided buffer is followed by exactly one invocation of the
+///     @ref CC_MqttsnCommitOutputBufferCb callback.
+/// @param[in] data Pointer to user data object, passed as last parameter to
+///     cc_mqttsn_client_set_output_buffer_callbacks() function.
+/// @param[in] bufLen Required buffer length in bytes.
+/// @return Pointer to the buffer of at least @b bufLen bytes, @b NULL if such
+///     buffer cannot be provided, the message is not sent then.
+/// @ingroup client
+typedef unsigned char* (*CC_MqttsnGetOutputBufferCb)(void* data, unsigned bufLen);
+
+/// @brief Callback used to request to send data previously written into the buffer
+///     provided by the @ref CC_MqttsnGetOutputBufferCb callback.
+/// @details The callback is set using
+///     cc_mqttsn_client_set_output_buffer_callbacks() function.
+/// @param[in] data Pointer to user data object, passed as last parameter to
+///     cc_mqttsn_client_set_output_buffer_callbacks() function.
+/// @param[in] buf Pointer to the buffer returned by the @ref CC_MqttsnGetOutputBufferCb callback.
+/// @param[in] bufLen Number of bytes to send. When @b 0, the buffer needs to be
+///     released without sending anything.
+/// @param[in] broadcastRadius Broadcast radius. When @b 0, means unicast to the connected gateway.
+/// @ingroup client
+typedef void (*CC_MqttsnCommitOutputBufferCb)(void* data, unsigned char* buf, unsigned bufLen, unsigned broadcastRadius);
+
 /// @brief Callback used to report gateway status.
 /// @details The callback is set using
 ///     cc_mqttsn_client_set_gw_status_report_callback() function.
@@ -490,6 +628,35 @@ typedef void (*CC_MqttsnWillCompleteCb)(void* data, CC_MqttsnAsyncOpStatus statu
 /// @ingroup sleep
 typedef void (*CC_MqttsnSleepCompleteCb)(void* data, CC_MqttsnAsyncOpStatus status);
 
+/// @brief Callback used to allocate memory for the internal objects.
+/// @details The callback is set using cc_mqttsn_client_set_alloc_callbacks() function.
+/// @param[in] data Pointer to user data object, passed as the last parameter to
+///     cc_mqttsn_client_set_alloc_callbacks() function.
+/// @param[in] size Number of bytes to allocate.
+/// @return Pointer to the allocated memory aligned to at least alignof(max_align_t),
+///     NULL on allocation failure.
+/// @ingroup client
+typedef void* (*CC_MqttsnAllocCb)(void* data, unsigned size);
+
+/// @brief Callback used to release memory allocated by the @ref CC_MqttsnAllocCb callback.
+/// @param[in] data Pointer to user data object, passed as the last parameter to
+///     cc_mqttsn_client_set_alloc_callbacks() function.
+/// @param[in] ptr Pointer to the memory returned by the @ref CC_MqttsnAllocCb callback.
+/// @param[in] size Number of bytes passed to the @ref CC_MqttsnAllocCb callback.
+/// @ingroup client
+typedef void (*CC_MqttsnFreeCb)(void* data, void* ptr, unsigned size);
+
+/// @brief Single "publish" request for the batch processing.
+/// @see cc_mqttsn_client_publish_batch()
+/// @ingroup publish
+typedef struct
+{
+    CC_MqttsnPublishConfig m_config; ///< Publish configuration.
+    CC_MqttsnPublishCompleteCb m_cb; ///< Callback to be invoked when "publish" operation is complete.
+    void* m_cbData; ///< Pointer to user data passed to the callback.
+    CC_MqttsnErrorCode m_ec; ///< Output: set by the library to report result of the request initiation.
+} CC_MqttsnPublishRequest;
+
 #ifdef __cplusplus
 }
 #endif
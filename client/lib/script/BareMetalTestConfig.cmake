@@ -48,3 +48,12 @@ set(CC_MQTTSN_CLIENT_IN_REG_TOPICS_LIMIT 20)
 
 # Limit the amount of output registered topics
 set(CC_MQTTSN_CLIENT_OUT_REG_TOPICS_LIMIT 20)
+
+# Exclude runtime statistics
+set(CC_MQTTSN_CLIENT_HAS_STATS FALSE)
+
+# Buffer up to 4 received frames from the interrupt context
+set(CC_MQTTSN_CLIENT_RX_RING_FRAMES 4)
+
+# Refer to the received data in the input buffer instead of copying it
+set(CC_MQTTSN_CLIENT_HAS_INPUT_DATA_VIEW TRUE)
@@ -24,12 +24,19 @@ set_default_var_value(CC_MQTTSN_CLIENT_TOPIC_FIELD_FIXED_LEN 0)
 set_default_var_value(CC_MQTTSN_CLIENT_DATA_FIELD_FIXED_LEN 0)
 set_default_var_value(CC_MQTTSN_CLIENT_MAX_OUTPUT_PACKET_SIZE 0)
 set_default_var_value(CC_MQTTSN_CLIENT_ASYNC_PUBS_LIMIT 0)
+set_default_var_value(CC_MQTTSN_CLIENT_ASYNC_PUBS_STORAGE_LIMIT 0)
+set_default_var_value(CC_MQTTSN_CLIENT_MAX_INFLIGHT_PUBS 0)
 set_default_var_value(CC_MQTTSN_CLIENT_ASYNC_SUBS_LIMIT 0)
 set_default_var_value(CC_MQTTSN_CLIENT_ASYNC_UNSUBS_LIMIT 0)
 set_default_var_value(CC_MQTTSN_CLIENT_HAS_ERROR_LOG TRUE)
+set_default_var_value(CC_MQTTSN_CLIENT_HAS_STATS TRUE)
 set_default_var_value(CC_MQTTSN_CLIENT_HAS_TOPIC_FORMAT_VERIFICATION TRUE)
 set_default_var_value(CC_MQTTSN_CLIENT_HAS_SUB_TOPIC_VERIFICATION TRUE)
 set_default_var_value(CC_MQTTSN_CLIENT_SUB_FILTERS_LIMIT 0)
 set_default_var_value(CC_MQTTSN_CLIENT_IN_REG_TOPICS_LIMIT 0)
 set_default_var_value(CC_MQTTSN_CLIENT_OUT_REG_TOPICS_LIMIT 0)
-set_default_var_value(CC_MQTTSN_CLIENT_MAX_QOS 2)
\ No newline at end of file
+set_default_var_value(CC_MQTTSN_CLIENT_MAX_QOS 2)
+set_default_var_value(CC_MQTTSN_CLIENT_RX_RING_FRAMES 0)
+set_default_var_value(CC_MQTTSN_CLIENT_RX_RING_FRAME_SIZE 0)
+set_default_var_value(CC_MQTTSN_CLIENT_HAS_INPUT_DATA_VIEW FALSE)
+set_default_var_value(CC_MQTTSN_CLIENT_HAS_IN_PLACE_MSG_ALLOC FALSE)
\ No newline at end of file
@@ -0,0 +1,8 @@
+# Name of the client API
+set (CC_MQTTSN_CLIENT_CUSTOM_NAME "in_place")
+
+# Decode the received messages without heap allocation
+set (CC_MQTTSN_CLIENT_HAS_IN_PLACE_MSG_ALLOC TRUE)
+
+# Refer to the received data in the input buffer instead of copying it
+set (CC_MQTTSN_CLIENT_HAS_INPUT_DATA_VIEW TRUE)
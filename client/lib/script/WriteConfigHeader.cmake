@@ -37,6 +37,7 @@ adjust_bool_value ("CC_MQTTSN_CLIENT_HAS_DYN_MEM_ALLOC" "CC_MQTTSN_CLIENT_HAS_DY
 adjust_bool_value ("CC_MQTTSN_CLIENT_HAS_GATEWAY_DISCOVERY" "CC_MQTTSN_CLIENT_HAS_GATEWAY_DISCOVERY_CPP")
 adjust_bool_value ("CC_MQTTSN_CLIENT_HAS_WILL" "CC_MQTTSN_CLIENT_HAS_WILL_CPP")
 adjust_bool_value ("CC_MQTTSN_CLIENT_HAS_ERROR_LOG" "CC_MQTTSN_CLIENT_HAS_ERROR_LOG_CPP")
+adjust_bool_value ("CC_MQTTSN_CLIENT_HAS_STATS" "CC_MQTTSN_CLIENT_HAS_STATS_CPP")
 adjust_bool_value ("CC_MQTTSN_CLIENT_HAS_TOPIC_FORMAT_VERIFICATION" "CC_MQTTSN_CLIENT_HAS_TOPIC_FORMAT_VERIFICATION_CPP")
 adjust_bool_value ("CC_MQTTSN_CLIENT_HAS_SUB_TOPIC_VERIFICATION" "CC_MQTTSN_CLIENT_HAS_SUB_TOPIC_VERIFICATION_CPP")
 
@@ -50,15 +51,20 @@ replace_in_text (CC_MQTTSN_CLIENT_GATEWAY_ADDR_FIXED_LEN)
 replace_in_text (CC_MQTTSN_CLIENT_HAS_WILL_CPP)
 replace_in_text (CC_MQTTSN_CLIENT_MAX_OUTPUT_PACKET_SIZE)
 replace_in_text (CC_MQTTSN_CLIENT_ASYNC_PUBS_LIMIT)
+replace_in_text (CC_MQTTSN_CLIENT_ASYNC_PUBS_STORAGE_LIMIT)
+replace_in_text (CC_MQTTSN_CLIENT_MAX_INFLIGHT_PUBS)
 replace_in_text (CC_MQTTSN_CLIENT_ASYNC_SUBS_LIMIT)
 replace_in_text (CC_MQTTSN_CLIENT_ASYNC_UNSUBS_LIMIT)
 replace_in_text (CC_MQTTSN_CLIENT_HAS_ERROR_LOG_CPP)
+replace_in_text (CC_MQTTSN_CLIENT_HAS_STATS_CPP)
 replace_in_text (CC_MQTTSN_CLIENT_HAS_TOPIC_FORMAT_VERIFICATION_CPP)
 replace_in_text (CC_MQTTSN_CLIENT_HAS_SUB_TOPIC_VERIFICATION_CPP)
 replace_in_text (CC_MQTTSN_CLIENT_SUB_FILTERS_LIMIT)
 replace_in_text (CC_MQTTSN_CLIENT_IN_REG_TOPICS_LIMIT)
 replace_in_text (CC_MQTTSN_CLIENT_OUT_REG_TOPICS_LIMIT)
 replace_in_text (CC_MQTTSN_CLIENT_MAX_QOS)
+replace_in_text (CC_MQTTSN_CLIENT_RX_RING_FRAMES)
+replace_in_text (CC_MQTTSN_CLIENT_RX_RING_FRAME_SIZE)
 
 file (WRITE "${OUT_FILE}.tmp" "${text}")
 
@@ -0,0 +1,184 @@
+# Expected input variables:
+# FOOTPRINT_EXE - Path to the footprint report executable.
+# EMULATOR - (Optional) Emulator to run the executable when cross-compiling.
+# LIB_FILE - Path to the built client library.
+# SECTIONS_LIB_FILE - (Optional) Path to the static copy of the client library compiled
+#   with the function and data sections, used to link the per API executables.
+# NM - (Optional) Path to the "nm" utility.
+# API_PREFIX - Prefix of the public API functions.
+# CXX - (Optional) C++ compiler used to link the per API executables.
+# CXX_FLAGS - (Optional) Extra compiler and linker flags for the per API executables.
+# WORK_DIR - Directory for the per API executables.
+# OUTPUT_FILE - Path to the output report file.
+
+if ("${FOOTPRINT_EXE}" STREQUAL "")
+    message (FATAL_ERROR "Footprint executable is not provided")
+endif ()
+
+if ("${OUTPUT_FILE}" STREQUAL "")
+    message (FATAL_ERROR "Output file is not provided")
+endif ()
+
+# Sums the sizes of the code symbols (T/t as well as W/w for inline functions and
+# template instantiations). The symbol emitted by several object files is counted once.
+function (footprint_code_size file out_var out_syms_var)
+    execute_process (
+        COMMAND ${NM} --print-size --radix=d ${file}
+        RESULT_VARIABLE nm_result
+        OUTPUT_VARIABLE nm_output
+        ERROR_QUIET
+    )
+
+    if (NOT "${nm_result}" STREQUAL "0")
+        set (${out_var} "" PARENT_SCOPE)
+        return ()
+    endif ()
+
+    # Lines are expected to be in "<address> <size> <type> <name>" format
+    string (REPLACE "\n" ";" nm_lines "${nm_output}")
+    set (entries)
+    foreach (line ${nm_lines})
+        if (NOT "${line}" MATCHES "^[0-9]+ ([0-9]+) [TtWw] (.+)$")
+            continue ()
+        endif ()
+
+        math (EXPR sym_size "${CMAKE_MATCH_1}") # Strip leading zeroes
+        list (APPEND entries "${CMAKE_MATCH_2} ${sym_size}")
+    endforeach ()
+
+    list (SORT entries)
+    set (total 0)
+    set (prev_name)
+    set (syms)
+    foreach (entry ${entries})
+        string (REGEX MATCH "^(.+) ([0-9]+)$" _ "${entry}")
+        if ("${CMAKE_MATCH_1}" STREQUAL "${prev_name}")
+            continue ()
+        endif ()
+
+        set (prev_name "${CMAKE_MATCH_1}")
+        math (EXPR total "${total} + ${CMAKE_MATCH_2}")
+        list (APPEND syms "${CMAKE_MATCH_1}")
+    endforeach ()
+
+    set (${out_var} ${total} PARENT_SCOPE)
+    set (${out_syms_var} ${syms} PARENT_SCOPE)
+endfunction ()
+
+# Links the minimal executable, which only references the provided API function,
+# against the library with unused sections removed and reports its code size.
+function (footprint_link_size func out_var)
+    set (exe_name "empty")
+    set (src_text "int main()\n{\n    return 0;\n}\n")
+    if (NOT "${func}" STREQUAL "")
+        set (exe_name "${func}")
+        set (src_text
+            "extern \"C\" void ${func}();\n\nint main()\n{\n    void (* volatile ptr)() = &${func};\n    return (ptr == nullptr) ? 1 : 0;\n}\n")
+    endif ()
+
+    set (src_file "${WORK_DIR}/${exe_name}.cpp")
+    set (exe_file "${WORK_DIR}/${exe_name}")
+    file (WRITE "${src_file}" "${src_text}")
+
+    separate_arguments (flags UNIX_COMMAND "${CXX_FLAGS}")
+    execute_process (
+        COMMAND ${CXX} ${flags} -Wl,--gc-sections -o ${exe_file} ${src_file} ${SECTIONS_LIB_FILE}
+        RESULT_VARIABLE link_result
+        OUTPUT_QUIET
+        ERROR_QUIET
+    )
+
+    if (NOT "${link_result}" STREQUAL "0")
+        set (${out_var} "" PARENT_SCOPE)
+        return ()
+    endif ()
+
+    footprint_code_size (${exe_file} size syms)
+    set (${out_var} ${size} PARENT_SCOPE)
+endfunction ()
+
+execute_process (
+    COMMAND ${EMULATOR} ${FOOTPRINT_EXE}
+    RESULT_VARIABLE exe_result
+    OUTPUT_VARIABLE report_text
+)
+
+if (NOT "${exe_result}" STREQUAL "0")
+    set (report_text "Failed to execute ${FOOTPRINT_EXE} (${exe_result}), set CMAKE_CROSSCOMPILING_EMULATOR when cross-compiling\n")
+endif ()
+
+if (("${NM}" STREQUAL "") OR ("${LIB_FILE}" STREQUAL ""))
+    string (APPEND report_text "\nCode size report is skipped, nm utility is not available\n")
+    file (WRITE ${OUTPUT_FILE} "${report_text}")
+    message ("${report_text}")
+    return ()
+endif ()
+
+footprint_code_size (${LIB_FILE} total_code_size lib_syms)
+if ("${total_code_size}" STREQUAL "")
+    string (APPEND report_text "\nCode size report is skipped, failed to execute ${NM}\n")
+    file (WRITE ${OUTPUT_FILE} "${report_text}")
+    message ("${report_text}")
+    return ()
+endif ()
+
+string (APPEND report_text "\nTotal code size of the library: ${total_code_size}\n")
+
+set (api_funcs)
+foreach (sym ${lib_syms})
+    if ("${sym}" MATCHES "^_?(${API_PREFIX}[A-Za-z0-9_]+)$")
+        list (APPEND api_funcs "${CMAKE_MATCH_1}")
+    endif ()
+endforeach ()
+
+set (link_skip_reason)
+if (("${CXX}" STREQUAL "") OR ("${SECTIONS_LIB_FILE}" STREQUAL ""))
+    set (link_skip_reason "linking with removal of unused sections is not supported by the compiler")
+endif ()
+
+if ("${link_skip_reason}" STREQUAL "")
+    file (REMOVE_RECURSE "${WORK_DIR}")
+    file (MAKE_DIRECTORY "${WORK_DIR}")
+    footprint_link_size ("" empty_size)
+    if ("${empty_size}" STREQUAL "")
+        set (link_skip_reason "failed to link the empty executable")
+    endif ()
+endif ()
+
+if (NOT "${link_skip_reason}" STREQUAL "")
+    string (APPEND report_text "\nPer API code size report is skipped, ${link_skip_reason}\n")
+    file (WRITE ${OUTPUT_FILE} "${report_text}")
+    message ("${report_text}")
+    return ()
+endif ()
+
+# Every API function is linked into its own executable, the reported size is the
+# increase over the empty executable, i.e. the function together with all the
+# internal code reachable from it.
+set (api_lines)
+foreach (func ${api_funcs})
+    footprint_link_size (${func} func_size)
+    if ("${func_size}" STREQUAL "")
+        list (APPEND api_lines "    failed  ${func}")
+        continue ()
+    endif ()
+
+    math (EXPR func_size "${func_size} - ${empty_size}")
+    string (LENGTH "${func_size}" size_len)
+    math (EXPR pad_len "10 - ${size_len}")
+    if (pad_len LESS 0)
+        set (pad_len 0)
+    endif ()
+
+    string (REPEAT " " ${pad_len} pad)
+    list (APPEND api_lines "${pad}${func_size}  ${func}")
+endforeach ()
+
+list (SORT api_lines)
+string (APPEND report_text "\nCode size of the public API functions including the reachable internals (linked alone with --gc-sections):\n")
+foreach (line ${api_lines})
+    string (APPEND report_text "${line}\n")
+endforeach ()
+
+file (WRITE ${OUTPUT_FILE} "${report_text}")
+message ("${report_text}")
@@ -41,11 +41,14 @@ set_default_opt (FIELD_DATA)
 set_default_opt (MAX_PACKET_SIZE)
 set_default_opt (MSG_ALLOC_OPT)
 
+set (IN_FIELD_DATA "BaseImpl::field::Data")
+set (IN_FIELD_TOPIC "BaseImpl::field::TopicName")
+
 #########################################
 
 # Update options
 
-if (NOT ${CC_MQTTSN_CLIENT_HAS_DYN_MEM_ALLOC})
+if ((NOT ${CC_MQTTSN_CLIENT_HAS_DYN_MEM_ALLOC}) OR ${CC_MQTTSN_CLIENT_HAS_IN_PLACE_MSG_ALLOC})
     set (MSG_ALLOC_OPT "comms::option::app::InPlaceAllocation")
 endif ()
 
@@ -91,6 +94,11 @@ elseif (NOT ${CC_MQTTSN_CLIENT_HAS_DYN_MEM_ALLOC})
     message (FATAL_ERROR "When dynamic memory allocation is disabled, the CC_MQTTSN_CLIENT_MAX_OUTPUT_PACKET_SIZE needs to be set")
 endif ()
 
+if (${CC_MQTTSN_CLIENT_HAS_INPUT_DATA_VIEW})
+    set (IN_FIELD_DATA "comms::option::app::OrigDataView")
+    set (IN_FIELD_TOPIC "comms::option::app::OrigDataView")
+endif ()
+
 #########################################
 
 replace_in_text (FIELD_GW_ADD)
@@ -102,6 +110,8 @@ replace_in_text (FIELD_DATA)
 
 replace_in_text (MAX_PACKET_SIZE)
 replace_in_text (MSG_ALLOC_OPT)
+replace_in_text (IN_FIELD_DATA)
+replace_in_text (IN_FIELD_TOPIC)
 
 file (WRITE "${OUT_FILE}.tmp" "${text}")
 
@@ -0,0 +1,97 @@
+//
+// Copyright 2026 - 2026 (C). Alex Robenko. All rights reserved.
+//
+// SPDX-License-Identifier: MPL-2.0
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "AllocHooks.h"
+
+#include "ExtConfig.h"
+
+#include "comms/Assert.h"
+
+#include <atomic>
+
+namespace cc_mqttsn_client
+{
+
+namespace
+{
+
+struct HooksState
+{
+    CC_MqttsnAllocCb m_allocCb = nullptr;
+    CC_MqttsnFreeCb m_freeCb = nullptr;
+    void* m_data = nullptr;
+    std::atomic<std::size_t> m_allocsCount{0U};
+};
+
+HooksState& hooksState()
+{
+    static HooksState State;
+    return State;
+}
+
+} // namespace
+
+CC_MqttsnErrorCode AllocHooks::setCallbacks(CC_MqttsnAllocCb allocCb, CC_MqttsnFreeCb freeCb, void* data)
+{
+    if constexpr (!ExtConfig::HasDynMemAlloc) {
+        return CC_MqttsnErrorCode_NotSupported;
+    }
+
+    if ((allocCb == nullptr) != (freeCb == nullptr)) {
+        return CC_MqttsnErrorCode_BadParam;
+    }
+
+    auto& state = hooksState();
+    if (state.m_allocsCount.load(std::memory_order_acquire) != 0U) {
+        // The memory allocated by the previous hooks is still in use
+        return CC_MqttsnErrorCode_Busy;
+    }
+
+    state.m_allocCb = allocCb;
+    state.m_freeCb = freeCb;
+    state.m_data = data;
+    return CC_MqttsnErrorCode_Success;
+}
+
+void* AllocHooks::alloc(std::size_t size)
+{
+    auto& state = hooksState();
+    void* ptr = nullptr;
+    if (state.m_allocCb != nullptr) {
+        ptr = state.m_allocCb(state.m_data, static_cast<unsigned>(size));
+    }
+    else {
+        ptr = ::operator new(size, std::nothrow);
+    }
+
+    if (ptr != nullptr) {
+        state.m_allocsCount.fetch_add(1U, std::memory_order_relaxed);
+    }
+
+    return ptr;
+}
+
+void AllocHooks::free(void* ptr, std::size_t size)
+{
+    if (ptr == nullptr) {
+        return;
+    }
+
+    auto& state = hooksState();
+    COMMS_ASSERT(0U < state.m_allocsCount.load(std::memory_order_relaxed));
+    state.m_allocsCount.fetch_sub(1U, std::memory_order_release);
+    if (state.m_freeCb != nullptr) {
+        state.m_freeCb(state.m_data, ptr, static_cast<unsigned>(size));
+        return;
+    }
+
+    ::operator delete(ptr);
+}
+
+} // namespace cc_mqttsn_client
@@ -0,0 +1,73 @@
+//
+// Copyright 2026 - 2026 (C). Alex Robenko. All rights reserved.
+//
+// SPDX-License-Identifier: MPL-2.0
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include "cc_mqttsn_client/common.h"
+
+#include <cstddef>
+#include <new>
+
+namespace cc_mqttsn_client
+{
+
+// Process wide memory allocation hooks, used by the dynamic memory allocation
+// build for the client objects, operations and the ObjListType storage.
+// When the hooks are not set the global operator new / delete are used.
+// The hooks are plain (non-atomic) pointers, they are expected to be set
+// during the single-threaded initialization before any client is allocated.
+class AllocHooks
+{
+public:
+    static CC_MqttsnErrorCode setCallbacks(CC_MqttsnAllocCb allocCb, CC_MqttsnFreeCb freeCb, void* data);
+    static void* alloc(std::size_t size);
+    static void free(void* ptr, std::size_t size);
+};
+
+// Standard allocator forwarding to the hooks, used by the dynamic containers
+template <typename T>
+class HooksAllocator
+{
+public:
+    using value_type = T;
+
+    HooksAllocator() = default;
+
+    template <typename U>
+    HooksAllocator([[maybe_unused]] const HooksAllocator<U>& other) {}
+
+    T* allocate(std::size_t count)
+    {
+        auto* ptr = AllocHooks::alloc(count * sizeof(T));
+        if (ptr == nullptr) {
+            throw std::bad_alloc();
+        }
+
+        return static_cast<T*>(ptr);
+    }
+
+    void deallocate(T* ptr, std::size_t count)
+    {
+        AllocHooks::free(ptr, count * sizeof(T));
+    }
+
+    template <typename U>
+    bool operator==([[maybe_unused]] const HooksAllocator<U>& other) const
+    {
+        return true;
+    }
+
+    template <typename U>
+    bool operator!=([[maybe_unused]] const HooksAllocator<U>& other) const
+    {
+        return false;
+    }
+};
+
+} // namespace cc_mqttsn_client
@@ -17,6 +17,8 @@
 #include "comms/util/assign.h"
 
 #include <algorithm>
+#include <iterator>
+#include <limits>
 #include <string_view>
 #include <type_traits>
 
@@ -57,119 +59,6 @@ void updateEc(CC_MqttsnErrorCode* ec, CC_MqttsnErrorCode val)
     }
 }
 
-InRegTopicsMap::iterator findInRegTopicInfoInternal(CC_MqttsnTopicId topicId, InRegTopicsMap& map)
-{
-    return
-        std::lower_bound(
-            map.begin(), map.end(), topicId,
-            [](auto& info, CC_MqttsnTopicId topicIdParam) {
-                return info.m_topicId < topicIdParam;
-            });
-}
-
-InRegTopicsMap::iterator findInRegTopicInfoInternal(const char* topic, InRegTopicsMap& map)
-{
-    return
-        std::find_if(
-            map.begin(), map.end(),
-            [topic](auto& info)
-            {
-                return info.m_topic == topic;
-            });
-}
-
-OutRegTopicsMap::iterator findOutRegTopicInfoInternal(CC_MqttsnTopicId topicId, OutRegTopicsMap& map)
-{
-    return
-        std::find_if(
-            map.begin(), map.end(),
-            [topicId](auto& info)
-            {
-                return info.m_topicId == topicId;
-            });
-}
-
-OutRegTopicsMap::iterator findOutRegTopicInfoInternal(const char* topic, InRegTopicsMap& map)
-{
-    return
-        std::lower_bound(
-            map.begin(), map.end(), topic,
-            [](auto& info, const char* topicParam) {
-                return info.m_topic < topicParam;
-            });
-}
-
-template <typename TMap>
-bool removeLeastRecentlyUsedRegTopicInfoIfNeeded(TMap& map, std::size_t limit)
-{
-    if (map.size() < limit) {
-        return false;
-    }
-
-    auto eraseIter =
-        std::min_element(
-            map.begin(), map.end(),
-            [](auto& info1, auto& info2)
-            {
-                return info1.m_timestamp < info2.m_timestamp;
-            });
-
-    COMMS_ASSERT(eraseIter != map.end());
-    map.erase(eraseIter);
-    return true;
-}
-
-bool isTopicMatch(std::string_view filter, std::string_view topic)
-{
-    if ((filter.size() == 1U) && (filter[0] == '#')) {
-        return true;
-    }
-
-    if (topic.empty()) {
-        return filter.empty();
-    }
-
-    auto filterSepPos = filter.find_first_of("/");
-    auto topicSepPos = topic.find_first_of("/");
-
-    if ((filterSepPos == std::string_view::npos) &&
-        (topicSepPos != std::string_view::npos)) {
-        return false;
-    }
-
-    if (topicSepPos != std::string_view::npos) {
-        COMMS_ASSERT(filterSepPos != std::string_view::npos);
-        if (((filter[0] == '+') && (filterSepPos == 1U)) ||
-            (filter.substr(0, filterSepPos) == topic.substr(0, topicSepPos))) {
-            return isTopicMatch(filter.substr(filterSepPos + 1U), topic.substr(topicSepPos + 1U));
-        }
-
-        return false;
-    }
-
-    if (filterSepPos != std::string_view::npos) {
-        COMMS_ASSERT(topicSepPos == std::string_view::npos);
-        if (filter.size() <= (filterSepPos + 1U)) {
-            // trailing '/' on the filter without any character after that
-            return false;
-        }
-
-        if (((filter[0] == '+') && (filterSepPos == 1U)) ||
-            (filter.substr(0, filterSepPos) == topic)) {
-            return isTopicMatch(filter.substr(filterSepPos + 1U), std::string_view());
-        }
-
-        return false;
-    }
-
-    COMMS_ASSERT(filterSepPos == std::string_view::npos);
-    COMMS_ASSERT(topicSepPos == std::string_view::npos);
-
-    return
-        (((filter[0] == '+') && (filter.size() == 1U)) ||
-         (filter == topic));
-}
-
 } // namespace
 
 ClientImpl::ClientImpl() :
@@ -190,6 +79,14 @@ ClientImpl::~ClientImpl()
 void ClientImpl::tick(unsigned ms)
 {
     COMMS_ASSERT(m_apiEnterCount == 0U);
+    if (m_clockCb != nullptr) {
+        // The programmed timer has expired, the elapsed time is
+        // measured using the clock.
+        m_programmedDeadline = NoDeadline;
+        auto guard = apiEnter();
+        return;
+    }
+
     ++m_apiEnterCount;
     m_clientState.m_timestamp += ms;
     m_timerMgr.tick(ms);
@@ -199,14 +96,58 @@ void ClientImpl::tick(unsigned ms)
 void ClientImpl::processData(const std::uint8_t* iter, unsigned len, CC_MqttsnDataOrigin origin)
 {
     auto guard = apiEnter();
+    processDataInternal(iter, len, origin);
+}
 
-    m_sessionState.m_lastOrigin = origin;
-    ProtFrame::MsgPtr msgPtr;
-    auto es = comms::processSingleWithDispatch(iter, len, m_frame, msgPtr, *this);
-    if (es != comms::ErrorStatus::Success) {
-        errorLog("Failed to decode the received message");
-        return;
+unsigned ClientImpl::processDataBatch(CC_MqttsnInputData* inputs, unsigned count)
+{
+    COMMS_ASSERT((inputs != nullptr) || (count == 0U));
+    auto guard = apiEnter();
+
+    unsigned failuresCount = 0U;
+    processFramesInternal(
+        count,
+        [this, inputs, &failuresCount](unsigned idx)
+        {
+            auto& info = inputs[idx];
+            info.m_decodeFailure = !processDataInternal(info.m_buf, info.m_bufLen, info.m_origin);
+            if (info.m_decodeFailure) {
+                ++failuresCount;
+            }
+        });
+
+    return failuresCount;
+}
+
+unsigned ClientImpl::rxRingDrain()
+{
+    if constexpr (!RxRing::isSupported()) {
+        return 0U;
+    }
+
+    if (m_apiEnterCount > 0U) {
+        errorLog("Cannot drain the receive ring from within callback");
+        return 0U;
+    }
+
+    // Process only the frames pushed so far, the ones pushed by the
+    // interrupt in the meantime will be processed on the next call.
+    auto count = m_rxRing.count();
+    if (count == 0U) {
+        return 0U;
     }
+
+    auto guard = apiEnter();
+    processFramesInternal(
+        count,
+        [this]([[maybe_unused]] unsigned idx)
+        {
+            auto& slot = m_rxRing.front();
+            processDataInternal(slot.m_buf.data(), slot.m_len, slot.m_origin);
+            m_rxRing.pop();
+        });
+
+    return count;
 }
 
 #if CC_MQTTSN_CLIENT_HAS_GATEWAY_DISCOVERY
@@ -255,7 +196,7 @@ op::SearchOp* ClientImpl::searchPrepare(CC_MqttsnErrorCode* ec)
         }
 
         m_preparationLocked = true;
-        m_ops.push_back(ptr.get());
+        addOp(ptr.get());
         m_searchOps.push_back(std::move(ptr));
         op = m_searchOps.back().get();
         updateEc(ec, CC_MqttsnErrorCode_Success);
@@ -323,7 +264,7 @@ op::ConnectOp* ClientImpl::connectPrepare(CC_MqttsnErrorCode* ec)
         }
 
         m_preparationLocked = true;
-        m_ops.push_back(ptr.get());
+        addOp(ptr.get());
         m_connectOps.push_back(std::move(ptr));
         op = m_connectOps.back().get();
         updateEc(ec, CC_MqttsnErrorCode_Success);
@@ -381,7 +322,7 @@ op::DisconnectOp* ClientImpl::disconnectPrepare(CC_MqttsnErrorCode* ec)
         }
 
         m_preparationLocked = true;
-        m_ops.push_back(ptr.get());
+        addOp(ptr.get());
         m_disconnectOps.push_back(std::move(ptr));
         op = m_disconnectOps.back().get();
         updateEc(ec, CC_MqttsnErrorCode_Success);
@@ -426,7 +367,7 @@ op::SubscribeOp* ClientImpl::subscribePrepare(CC_MqttsnErrorCode* ec)
         }
 
         m_preparationLocked = true;
-        m_ops.push_back(ptr.get());
+        addOp(ptr.get());
         m_subscribeOps.push_back(std::move(ptr));
         op = m_subscribeOps.back().get();
 
@@ -477,7 +418,7 @@ op::UnsubscribeOp* ClientImpl::unsubscribePrepare(CC_MqttsnErrorCode* ec)
         }
 
         m_preparationLocked = true;
-        m_ops.push_back(ptr.get());
+        addOp(ptr.get());
         m_unsubscribeOps.push_back(std::move(ptr));
         op = m_unsubscribeOps.back().get();
 
@@ -528,12 +469,17 @@ op::SendOp* ClientImpl::publishPrepare(CC_MqttsnErrorCode* ec)
         }
 
         m_preparationLocked = true;
-        m_ops.push_back(ptr.get());
+        addOp(ptr.get());
         m_sendOps.push_back(std::move(ptr));
         op = m_sendOps.back().get();
 
-        if (1U < m_sendOps.size()) {
-            // Only one PUBLISH transaction is allowed at a time by the specification
+        // Only one PUBLISH transaction is allowed at a time by the specification,
+        // unless configured otherwise. The operations are resumed in order of preparation.
+        bool mustSuspend =
+            (m_configState.m_inflightPubsLimit < m_sendOps.size()) ||
+            ((1U < m_sendOps.size()) && (m_sendOps[m_sendOps.size() - 2U]->isSuspended()));
+
+        if (mustSuspend) {
             op->suspend();
         }
 
@@ -607,7 +553,7 @@ op::WillOp* ClientImpl::willPrepare(CC_MqttsnErrorCode* ec)
         }
 
         m_preparationLocked = true;
-        m_ops.push_back(ptr.get());
+        addOp(ptr.get());
         m_willOps.push_back(std::move(ptr));
         op = m_willOps.back().get();
         updateEc(ec, CC_MqttsnErrorCode_Success);
@@ -659,6 +605,252 @@ std::size_t ClientImpl::getIncomingRegTopicsLimit() const
     return m_clientState.m_inRegTopicsLimit;
 }
 
+CC_MqttsnErrorCode ClientImpl::prepareTopic(const char* topic, CC_MqttsnPreparedTopic* prepared)
+{
+    if (prepared == nullptr) {
+        errorLog("Prepared topic is not provided.");
+        return CC_MqttsnErrorCode_BadParam;
+    }
+
+    if ((topic == nullptr) || (topic[0] == '\0')) {
+        errorLog("Topic for preparation is not provided.");
+        return CC_MqttsnErrorCode_BadParam;
+    }
+
+    if (!verifyPubTopic(topic, true)) {
+        errorLog("Bad topic format for preparation.");
+        return CC_MqttsnErrorCode_BadParam;
+    }
+
+    using TopicIdType = PublishMsg::Field_flags::Field_topicIdType::ValueType;
+    *prepared = CC_MqttsnPreparedTopic();
+    prepared->m_topic = topic;
+    prepared->m_client = this;
+    prepared->m_topicIdType = static_cast<unsigned>(TopicIdType::Normal);
+
+    if (op::Op::isShortTopic(topic)) {
+        prepared->m_topicId =
+            static_cast<CC_MqttsnTopicId>(
+                (static_cast<std::uint16_t>(topic[0]) << 8U) |
+                (static_cast<std::uint8_t>(topic[1])));
+        prepared->m_topicIdType = static_cast<unsigned>(TopicIdType::ShortTopicName);
+        return CC_MqttsnErrorCode_Success;
+    }
+
+    // The topic may be unknown yet, it will be registered by the first publish
+    [[maybe_unused]] auto resolved = resolvePreparedTopic(*prepared);
+    return CC_MqttsnErrorCode_Success;
+}
+
+CC_MqttsnErrorCode ClientImpl::publishQos0(const CC_MqttsnPublishConfig* config, CC_MqttsnPreparedTopic* prepared)
+{
+    if (config == nullptr) {
+        errorLog("Publish configuration is not provided.");
+        return CC_MqttsnErrorCode_BadParam;
+    }
+
+    if (m_sessionState.m_connectionStatus != CC_MqttsnConnectionStatus_Connected) {
+        errorLog("Client must be connected to allow publish.");
+        return CC_MqttsnErrorCode_NotConnected;
+    }
+
+    if (m_sessionState.m_disconnecting) {
+        errorLog("Session disconnection is in progress, cannot initiate publish.");
+        return CC_MqttsnErrorCode_Disconnecting;
+    }
+
+    if (config->m_qos != CC_MqttsnQoS_AtMostOnceDelivery) {
+        errorLog("Only QoS0 is allowed for immediate publish.");
+        return CC_MqttsnErrorCode_BadParam;
+    }
+
+    if ((0U < config->m_dataLen) && (config->m_data == nullptr)) {
+        errorLog("Bad publish message data.");
+        return CC_MqttsnErrorCode_BadParam;
+    }
+
+    // No operation is allocated, the message is sent right away
+    // and the payload is not copied into the message object.
+    using TopicIdType = PublishMsg::Field_flags::Field_topicIdType::ValueType;
+    PublishMsg msg;
+    msg.field_flags().field_qos().setValue(CC_MqttsnQoS_AtMostOnceDelivery);
+    msg.field_flags().field_mid().setBitValue_Retain(config->m_retain);
+
+    do {
+        if (prepared != nullptr) {
+            if ((prepared->m_topic == nullptr) || (prepared->m_client != this)) {
+                errorLog("Invalid prepared topic in publish.");
+                return CC_MqttsnErrorCode_BadParam;
+            }
+
+            if (!resolvePreparedTopic(*prepared)) {
+                errorLog("The prepared topic hasn't been registered yet.");
+                return CC_MqttsnErrorCode_InsufficientConfig;
+            }
+
+            msg.field_topicId().setValue(prepared->m_topicId);
+            msg.field_flags().field_topicIdType().value() = static_cast<TopicIdType>(prepared->m_topicIdType);
+            break;
+        }
+
+        bool emptyTopic =
+            (config->m_topic == nullptr) ||
+            (config->m_topic[0] == '\0');
+
+        if (emptyTopic) {
+            if (!op::Op::isValidTopicId(config->m_topicId)) {
+                errorLog("Neither topic nor pre-defined topic ID are provided in PUBLISH configuration.");
+                return CC_MqttsnErrorCode_BadParam;
+            }
+
+            msg.field_topicId().setValue(config->m_topicId);
+            msg.field_flags().field_topicIdType().value() = TopicIdType::PredefinedTopicId;
+            break;
+        }
+
+        if (!verifyPubTopic(config->m_topic, true)) {
+            errorLog("Bad topic filter format in publish.");
+            return CC_MqttsnErrorCode_BadParam;
+        }
+
+        if (op::Op::isShortTopic(config->m_topic)) {
+            auto topicId =
+                (static_cast<std::uint16_t>(config->m_topic[0]) << 8U) |
+                (static_cast<std::uint8_t>(config->m_topic[1]));
+            msg.field_topicId().setValue(topicId);
+            msg.field_flags().field_topicIdType().value() = TopicIdType::ShortTopicName;
+            break;
+        }
+
+        auto topicId = findOutRegTopicId(config->m_topic);
+        if (topicId == 0U) {
+            errorLog("The publish topic hasn't been registered yet.");
+            return CC_MqttsnErrorCode_InsufficientConfig;
+        }
+
+        msg.field_topicId().setValue(topicId);
+        msg.field_flags().field_topicIdType().value() = TopicIdType::Normal;
+    } while (false);
+
+    auto guard = apiEnter();
+    return sendMessage(msg, config->m_data, config->m_dataLen, true);
+}
+
+unsigned ClientImpl::publishBatch(CC_MqttsnPublishRequest* requests, unsigned count)
+{
+    COMMS_ASSERT((requests != nullptr) || (count == 0U));
+    auto guard = apiEnter();
+
+    unsigned failuresCount = 0U;
+    for (auto idx = 0U; idx < count; ++idx) {
+        auto& req = requests[idx];
+        req.m_ec = CC_MqttsnErrorCode_Success;
+        do {
+            auto* op = publishPrepare(&req.m_ec);
+            if (op == nullptr) {
+                break;
+            }
+
+            req.m_ec = op->config(&req.m_config);
+            if (req.m_ec != CC_MqttsnErrorCode_Success) {
+                [[maybe_unused]] auto ecTmp = op->cancel();
+                break;
+            }
+
+            // The operation is released by itself on failure
+            req.m_ec = op->send(req.m_cb, req.m_cbData);
+        } while (false);
+
+        if (req.m_ec != CC_MqttsnErrorCode_Success) {
+            ++failuresCount;
+        }
+
+        if (m_apiEnterCount == 1U) {
+            // Release slots of the completed operations to allow
+            // allocation of the new ones while processing the rest of the batch.
+            cleanOps();
+        }
+    }
+
+    return failuresCount;
+}
+
+CC_MqttsnErrorCode ClientImpl::getStats(CC_MqttsnClientStats* stats) const
+{
+    if constexpr (!Config::HasStats) {
+        return CC_MqttsnErrorCode_NotSupported;
+    }
+
+    if (stats == nullptr) {
+        return CC_MqttsnErrorCode_BadParam;
+    }
+
+    stats().fill(*stats);
+    stats->m_opsCount =
+        static_cast<unsigned>(
+            std::count_if(
+                m_ops.begin(), m_ops.end(),
+                [](auto* op)
+                {
+                    return op != nullptr;
+                }));
+
+    return CC_MqttsnErrorCode_Success;
+}
+
+CC_MqttsnErrorCode ClientImpl::resetStats()
+{
+    if constexpr (!Config::HasStats) {
+        return CC_MqttsnErrorCode_NotSupported;
+    }
+
+    stats().reset();
+    return CC_MqttsnErrorCode_Success;
+}
+
+CC_MqttsnErrorCode ClientImpl::setInflightPubsLimit(unsigned limit)
+{
+    if (limit == 0U) {
+        limit = ConfigState::DefaultInflightPubsLimit;
+    }
+
+    if ((0U < Config::MaxInflightPubs) && (Config::MaxInflightPubs < limit)) {
+        errorLog("The specified limit for in flight publishes is too high");
+        return CC_MqttsnErrorCode_BadParam;
+    }
+
+    auto guard = apiEnter();
+    m_configState.m_inflightPubsLimit = limit;
+    resumeSendOps();
+    return CC_MqttsnErrorCode_Success;
+}
+
+CC_MqttsnErrorCode ClientImpl::setOpsSlabLimit(unsigned limit)
+{
+    if constexpr (!ExtConfig::HasDynMemAlloc) {
+        errorLog("The operations slab is not supported without dynamic memory allocation");
+        return CC_MqttsnErrorCode_NotSupported;
+    }
+
+#if CC_MQTTSN_CLIENT_HAS_GATEWAY_DISCOVERY
+    m_searchOpAlloc.setSlabLimit(limit);
+#endif // #if CC_MQTTSN_CLIENT_HAS_GATEWAY_DISCOVERY
+
+    m_connectOpAlloc.setSlabLimit(limit);
+    m_keepAliveOpsAlloc.setSlabLimit(limit);
+    m_disconnectOpsAlloc.setSlabLimit(limit);
+    m_subscribeOpsAlloc.setSlabLimit(limit);
+    m_unsubscribeOpsAlloc.setSlabLimit(limit);
+    m_sendOpsAlloc.setSlabLimit(limit);
+    m_sendOpStoragesAlloc.setSlabLimit(limit);
+
+#if CC_MQTTSN_CLIENT_HAS_WILL
+    m_willOpAlloc.setSlabLimit(limit);
+#endif // #if CC_MQTTSN_CLIENT_HAS_WILL
+
+    return CC_MqttsnErrorCode_Success;
+}
+
 CC_MqttsnErrorCode ClientImpl::asleepCheckMessages()
 {
     if (m_sessionState.m_connectionStatus != CC_MqttsnConnectionStatus_Asleep) {
@@ -874,7 +1066,34 @@ void ClientImpl::handle(GwinfoMsg& msg)
 }
 #endif // #if CC_MQTTSN_CLIENT_HAS_GATEWAY_DISCOVERY
 
-void ClientImpl::handle(RegisterMsg& msg)
+void ClientImpl::handle(ConnackMsg& msg)
+{
+    dispatchToSingleOp(msg, m_connectOps);
+}
+
+#if CC_MQTTSN_CLIENT_HAS_WILL
+void ClientImpl::handle(WilltopicreqMsg& msg)
+{
+    dispatchToSingleOp(msg, m_connectOps);
+}
+
+void ClientImpl::handle(WillmsgreqMsg& msg)
+{
+    dispatchToSingleOp(msg, m_connectOps);
+}
+
+void ClientImpl::handle(WilltopicrespMsg& msg)
+{
+    dispatchToSingleOp(msg, m_willOps);
+}
+
+void ClientImpl::handle(WillmsgrespMsg& msg)
+{
+    dispatchToSingleOp(msg, m_willOps);
+}
+#endif // #if CC_MQTTSN_CLIENT_HAS_WILL
+
+void ClientImpl::handle(InRegisterMsg& msg)
 {
     if (m_sessionState.m_lastOrigin != CC_MqttsnDataOrigin_ConnectedGw) {
         return;
@@ -885,9 +1104,7 @@ void ClientImpl::handle(RegisterMsg& msg)
         return;
     }
 
-    for (auto& opPtr : m_keepAliveOps) {
-        msg.dispatch(*opPtr);
-    }
+    dispatchToOps(msg, m_keepAliveOps);
 
     using RetCodeType = RegackMsg::Field_returnCode::ValueType;
     auto retCode = RetCodeType::Accepted;
@@ -903,8 +1120,18 @@ void ClientImpl::handle(RegisterMsg& msg)
                 sendMessage(resp);
             });
 
-    auto& topic = msg.field_topicName().value();
-    if ((topic.empty()) || (!verifyPubTopic(topic.c_str(), false))) {
+    // The received topic may refer to the input buffer without
+    // terminating zero, copy it first.
+    auto& topicField = msg.field_topicName().value();
+    TopicNameStr topic;
+    if ((topicField.empty()) || (topic.max_size() < topicField.size())) {
+        errorLog("Received REGISTER with invalid topic length.");
+        retCode = RetCodeType::NotSupported;
+        return; // Sends REGACK on exit
+    }
+
+    comms::util::assign(topic, topicField.begin(), topicField.end());
+    if (!verifyPubTopic(topic.c_str(), false)) {
         errorLog("Received REGISTER with invalid topic format.");
         retCode = RetCodeType::NotSupported;
         return; // Sends REGACK on exit
@@ -920,7 +1147,7 @@ void ClientImpl::handle(RegisterMsg& msg)
     return; // Sends REGACK on exit
 }
 
-void ClientImpl::handle(PublishMsg& msg)
+void ClientImpl::handle(InPublishMsg& msg)
 {
     if (m_sessionState.m_lastOrigin != CC_MqttsnDataOrigin_ConnectedGw) {
         return;
@@ -931,9 +1158,7 @@ void ClientImpl::handle(PublishMsg& msg)
         return;
     }
 
-    for (auto& opPtr : m_keepAliveOps) {
-        msg.dispatch(*opPtr);
-    }
+    dispatchToOps(msg, m_keepAliveOps);
 
     using ReturnCode = PubackMsg::Field_returnCode::ValueType;
     auto sendPuback =
@@ -968,22 +1193,20 @@ void ClientImpl::handle(PublishMsg& msg)
             break;
         }
 
-        auto& inRegMap = m_reuseState.m_inRegTopics;
-        auto inIter = findInRegTopicInfoInternal(topicId, inRegMap);
-        if ((inIter != inRegMap.end()) && (inIter->m_topicId == topicId)) {
-            COMMS_ASSERT(!inIter->m_topic.empty());
-            topic = std::string_view(inIter->m_topic.c_str(), inIter->m_topic.size());
+        auto* inInfo = m_reuseState.m_inRegTopics.findTopicId(topicId);
+        if (inInfo != nullptr) {
+            COMMS_ASSERT(!inInfo->m_topic.empty());
+            topic = std::string_view(inInfo->m_topic.c_str(), inInfo->m_topic.size());
             break;
         }
 
-        auto& outRegMap = m_reuseState.m_outRegTopics;
-        auto outIter = findOutRegTopicInfoInternal(topicId, outRegMap);
-        if ((outIter != outRegMap.end()) && (outIter->m_topicId == topicId)) {
-            COMMS_ASSERT(!outIter->m_topic.empty());
-            topic = std::string_view(outIter->m_topic.c_str(), outIter->m_topic.size());
+        auto* outInfo = m_reuseState.m_outRegTopics.findTopicId(topicId);
+        if (outInfo != nullptr) {
+            COMMS_ASSERT(!outInfo->m_topic.empty());
+            topic = std::string_view(outInfo->m_topic.c_str(), outInfo->m_topic.size());
 
             // For future use, copy it into input topics as well
-            storeInRegTopic(outIter->m_topic.c_str(), topicId);
+            storeInRegTopic(outInfo->m_topic.c_str(), topicId);
             break;
         }
 
@@ -1007,17 +1230,8 @@ void ClientImpl::handle(PublishMsg& msg)
             auto& subFilters = m_reuseState.m_subFilters;
 
             if (topicIdType == TopicIdType::PredefinedTopicId) {
-                auto iter =
-                    std::find_if(
-                        subFilters.begin(), subFilters.end(),
-                        [topicId](const auto& info)
-                        {
-                            return
-                                (info.m_topicId == topicId) &&
-                                (info.m_topic.empty());
-                        });
-
-                if (iter == subFilters.end()) {
+                if (!subFilters.hasTopicId(topicId)) {
+                    stats().unsubscribedMessageDropped();
                     errorLog("Received PUBLISH on non-subscribed pre-defined topic ID");
                     return;
                 }
@@ -1031,15 +1245,8 @@ void ClientImpl::handle(PublishMsg& msg)
                 return;
             }
 
-            auto iter =
-                std::find_if(
-                    subFilters.begin(), subFilters.end(),
-                    [&topic](auto& info)
-                    {
-                        return isTopicMatch(std::string_view(info.m_topic.c_str(), info.m_topic.size()), topic);
-                    });
-
-            if (iter == subFilters.end()) {
+            if (!subFilters.isMatch(topic)) {
+                stats().unsubscribedMessageDropped();
                 errorLog("Received PUBLISH on non-subscribed topic");
                 return;
             }
@@ -1125,6 +1332,11 @@ void ClientImpl::handle(PublishMsg& msg)
     reportMsgOnExit.release();
 }
 
+void ClientImpl::handle(RegackMsg& msg)
+{
+    dispatchToMsgIdOp(msg, msg.field_msgId().value());
+}
+
 void ClientImpl::handle(PubackMsg& msg)
 {
     if (m_sessionState.m_lastOrigin != CC_MqttsnDataOrigin_ConnectedGw) {
@@ -1136,45 +1348,26 @@ void ClientImpl::handle(PubackMsg& msg)
         return;
     }
 
-    for (auto& opPtr : m_keepAliveOps) {
-        msg.dispatch(*opPtr);
-    }
+    dispatchToOps(msg, m_keepAliveOps);
 
-    auto iter = m_sendOps.end();
+    op::Op* op = nullptr;
     if constexpr (Config::MaxQos >= 1) {
-        iter =
-            std::find_if(
-                m_sendOps.begin(), m_sendOps.end(),
-                [&msg](auto& opPtr)
-                {
-                    COMMS_ASSERT(opPtr);
-                    return opPtr->publishMsgId() == msg.field_msgId().value();
-                });
+        op = m_clientState.m_msgIdOps.find(msg.field_msgId().value());
     }
 
     auto retCode = static_cast<CC_MqttsnReturnCode>(msg.field_returnCode().value());
     if (retCode == CC_MqttsnReturnCode_InvalidTopicId) {
-        auto& map = m_reuseState.m_outRegTopics;
-        auto topicId = msg.field_topicId().value();
-        map.erase(
-            std::remove_if(
-                map.begin(), map.end(),
-                [topicId](auto& elem)
-                {
-                    return topicId == elem.m_topicId;
-                }),
-            map.end());
+        m_reuseState.m_outRegTopics.eraseTopicId(msg.field_topicId().value());
     }
 
-    if ((iter == m_sendOps.end()) &&
+    if ((op == nullptr) &&
         (msg.field_msgId().value() != 0U)) {
         errorLog("PUBACK with uknown msg id");
         return;
     }
 
-    if (iter != m_sendOps.end()) {
-        COMMS_ASSERT(*iter);
-        msg.dispatch(**iter);
+    if (op != nullptr) {
+        dispatchToOp(msg, *op);
     }
 }
 
@@ -1207,22 +1400,45 @@ void ClientImpl::handle(PubrelMsg& msg)
         errorLog("Failed to send PUBCOMP message");
     }
 }
+
+void ClientImpl::handle(PubrecMsg& msg)
+{
+    dispatchToMsgIdOp(msg, msg.field_msgId().value());
+}
+
+void ClientImpl::handle(PubcompMsg& msg)
+{
+    dispatchToMsgIdOp(msg, msg.field_msgId().value());
+}
 #endif // #if CC_MQTTSN_CLIENT_MAX_QOS >= 2
 
-void ClientImpl::handle([[maybe_unused]] PingreqMsg& msg)
+void ClientImpl::handle(SubackMsg& msg)
 {
-    if (m_sessionState.m_lastOrigin != CC_MqttsnDataOrigin_ConnectedGw) {
-        return;
-    }
+    dispatchToMsgIdOp(msg, msg.field_msgId().value());
+}
+
+void ClientImpl::handle(UnsubackMsg& msg)
+{
+    dispatchToMsgIdOp(msg, msg.field_msgId().value());
+}
+
+void ClientImpl::handle([[maybe_unused]] PingreqMsg& msg)
+{
+    if (m_sessionState.m_lastOrigin != CC_MqttsnDataOrigin_ConnectedGw) {
+        return;
+    }
 
     if ((m_sessionState.m_disconnecting) ||
         (m_sessionState.m_connectionStatus != CC_MqttsnConnectionStatus_Connected)) {
         return;
     }
 
-    for (auto& opPtr : m_keepAliveOps) {
-        msg.dispatch(*opPtr);
-    }
+    dispatchToOps(msg, m_keepAliveOps);
+}
+
+void ClientImpl::handle(PingrespMsg& msg)
+{
+    dispatchToKeepAliveOps(msg);
 }
 
 void ClientImpl::handle(DisconnectMsg& msg)
@@ -1241,49 +1457,41 @@ void ClientImpl::handle(DisconnectMsg& msg)
         return;
     }
 
-    for (auto& opPtr : m_disconnectOps) {
-        msg.dispatch(*opPtr);
-    }
+    dispatchToOps(msg, m_disconnectOps);
 }
 
-void ClientImpl::handle([[maybe_unused]] ProtMessage& msg)
+void ClientImpl::handle(ProtMessage& msg)
 {
-    if (m_sessionState.m_lastOrigin != CC_MqttsnDataOrigin_ConnectedGw) {
-        return;
-    }
+    // The messages that are not routed to the specific operations
+    // are only monitored by the keep alive operation.
+    dispatchToKeepAliveOps(msg);
+}
 
-    if (m_sessionState.m_disconnecting) {
-        return;
-    }
+CC_MqttsnErrorCode ClientImpl::sendMessage(const ProtMessage& msg, unsigned broadcastRadius)
+{
+    auto len = m_frame.length(msg);
 
-    // During the dispatch to callbacks can be called and new ops issues,
-    // the m_ops vector can be resized and iterators invalidated.
-    // As the result, the iteration needs to be performed using indices
-    // instead of iterators.
-    // Also do not dispatch the message to new ops.
-    auto count = m_ops.size();
-    for (auto idx = 0U; idx < count; ++idx) {
-        auto* op = m_ops[idx];
-        if (op == nullptr) {
-            // ops can be deleted, but the pointer will be nullified
-            // until last api guard.
-            continue;
+    if (m_getOutputBufferCb != nullptr) {
+        COMMS_ASSERT(m_commitOutputBufferCb != nullptr);
+        auto* outBuf = m_getOutputBufferCb(m_outputBufferData, static_cast<unsigned>(len));
+        if (outBuf == nullptr) {
+            errorLog("Failed to get output buffer.");
+            return CC_MqttsnErrorCode_BufferOverflow;
         }
 
-        msg.dispatch(*op);
-
-        // After message dispatching the whole session may be in terminating state
-        // Don't continue iteration
-
-        if (m_sessionState.m_disconnecting) {
-            break;
+        auto writeIter = comms::writeIteratorFor<ProtMessage>(outBuf);
+        auto es = m_frame.write(msg, writeIter, len);
+        COMMS_ASSERT(es == comms::ErrorStatus::Success);
+        if (es != comms::ErrorStatus::Success) {
+            m_commitOutputBufferCb(m_outputBufferData, outBuf, 0U, broadcastRadius);
+            errorLog("Failed to serialize output message.");
+            return CC_MqttsnErrorCode_InternalError;
         }
-    }
-}
 
-CC_MqttsnErrorCode ClientImpl::sendMessage(const ProtMessage& msg, unsigned broadcastRadius)
-{
-    auto len = m_frame.length(msg);
+        m_commitOutputBufferCb(m_outputBufferData, outBuf, static_cast<unsigned>(len), broadcastRadius);
+        messageSentInternal(msg, len);
+        return CC_MqttsnErrorCode_Success;
+    }
 
     if (m_buf.max_size() < len) {
         errorLog("Output buffer overflow.");
@@ -1299,49 +1507,166 @@ CC_MqttsnErrorCode ClientImpl::sendMessage(const ProtMessage& msg, unsigned broa
         return CC_MqttsnErrorCode_InternalError;
     }
 
-    COMMS_ASSERT(m_sendOutputDataCb != nullptr);
-    m_sendOutputDataCb(m_sendOutputDataData, &m_buf[0], static_cast<unsigned>(len), broadcastRadius);
+    reportOutputInternal(msg, &m_buf[0], static_cast<unsigned>(len), nullptr, 0U, broadcastRadius);
+    return CC_MqttsnErrorCode_Success;
+}
 
-    for (auto& opPtr : m_keepAliveOps) {
-        opPtr->messageSent();
+CC_MqttsnErrorCode ClientImpl::sendMessage(const ProtMessage& msg, const std::uint8_t* payload, unsigned payloadLen, bool lentPayload, unsigned broadcastRadius)
+{
+    if (payloadLen == 0U) {
+        return sendMessage(msg, broadcastRadius);
+    }
+
+    COMMS_ASSERT(payload != nullptr);
+
+    // The message is serialized without the payload, which is expected to
+    // be the last field. The length prefix is updated afterwards to include the payload
+    // and may require the long (3 bytes) form.
+    static constexpr std::size_t ShortLengthPrefixLen = 1U;
+    static constexpr std::size_t LongLengthPrefixLen = 3U;
+    static constexpr std::size_t PrefixReserveLen = LongLengthPrefixLen - ShortLengthPrefixLen;
+    static constexpr std::size_t MaxShortLength = std::numeric_limits<std::uint8_t>::max();
+    static constexpr std::uint8_t LongLengthMarker = 1U;
+
+    auto hdrLen = m_frame.length(msg);
+    COMMS_ASSERT(ShortLengthPrefixLen < hdrLen);
+    COMMS_ASSERT(hdrLen <= MaxShortLength);
+
+    auto fullLen = hdrLen + payloadLen;
+    auto prefixLen = ShortLengthPrefixLen;
+    if (MaxShortLength < fullLen) {
+        fullLen += PrefixReserveLen;
+        prefixLen = LongLengthPrefixLen;
+    }
+
+    if (std::numeric_limits<std::uint16_t>::max() < fullLen) {
+        errorLog("Output message is too long.");
+        return CC_MqttsnErrorCode_BufferOverflow;
+    }
+
+    // The space for the long length prefix is reserved only when it's really needed
+    auto hdrOffset = prefixLen - ShortLengthPrefixLen;
+    auto fullHdrLen = hdrOffset + hdrLen;
+    COMMS_ASSERT(fullHdrLen == (fullLen - payloadLen));
+
+    auto writeHeader =
+        [this, &msg, hdrOffset, hdrLen, prefixLen, fullLen](std::uint8_t* buf)
+        {
+            auto writeIter = comms::writeIteratorFor<ProtMessage>(buf + hdrOffset);
+            auto es = m_frame.write(msg, writeIter, hdrLen);
+            COMMS_ASSERT(es == comms::ErrorStatus::Success);
+            if (es != comms::ErrorStatus::Success) {
+                return es;
+            }
+
+            COMMS_ASSERT(buf[hdrOffset] == hdrLen);
+            if (prefixLen == ShortLengthPrefixLen) {
+                buf[0] = static_cast<std::uint8_t>(fullLen);
+                return es;
+            }
+
+            buf[0] = LongLengthMarker;
+            buf[1] = static_cast<std::uint8_t>(fullLen >> 8U);
+            buf[2] = static_cast<std::uint8_t>(fullLen);
+            return es;
+        };
+
+    if (m_getOutputBufferCb != nullptr) {
+        COMMS_ASSERT(m_commitOutputBufferCb != nullptr);
+        auto* outBuf = m_getOutputBufferCb(m_outputBufferData, static_cast<unsigned>(fullLen));
+        if (outBuf == nullptr) {
+            errorLog("Failed to get output buffer.");
+            return CC_MqttsnErrorCode_BufferOverflow;
+        }
+
+        if (writeHeader(outBuf) != comms::ErrorStatus::Success) {
+            m_commitOutputBufferCb(m_outputBufferData, outBuf, 0U, broadcastRadius);
+            errorLog("Failed to serialize output message.");
+            return CC_MqttsnErrorCode_InternalError;
+        }
+
+        std::copy_n(payload, payloadLen, outBuf + fullHdrLen);
+        m_commitOutputBufferCb(m_outputBufferData, outBuf, static_cast<unsigned>(fullLen), broadcastRadius);
+        messageSentInternal(msg, fullLen);
+        return CC_MqttsnErrorCode_Success;
+    }
+
+    // Only the payload lent by the application is reported as a separate segment,
+    // the payload owned by the client is sent in a single buffer together with the header.
+    bool copyPayload = (!lentPayload) || (m_sendOutputSegmentsCb == nullptr);
+    auto bufLen = fullHdrLen;
+    if (copyPayload) {
+        bufLen += payloadLen;
+    }
+
+    if (m_buf.max_size() < bufLen) {
+        errorLog("Output buffer overflow.");
+        return CC_MqttsnErrorCode_BufferOverflow;
     }
 
+    m_buf.resize(bufLen);
+    if (writeHeader(&m_buf[0]) != comms::ErrorStatus::Success) {
+        errorLog("Failed to serialize output message.");
+        return CC_MqttsnErrorCode_InternalError;
+    }
+
+    if (copyPayload) {
+        std::copy_n(payload, payloadLen, &m_buf[fullHdrLen]);
+        reportOutputInternal(msg, &m_buf[0], static_cast<unsigned>(fullLen), nullptr, 0U, broadcastRadius);
+        return CC_MqttsnErrorCode_Success;
+    }
+
+    reportOutputInternal(msg, &m_buf[0], static_cast<unsigned>(fullHdrLen), payload, payloadLen, broadcastRadius);
     return CC_MqttsnErrorCode_Success;
 }
 
 void ClientImpl::opComplete(const op::Op* op)
 {
-    auto iter = std::find(m_ops.begin(), m_ops.end(), op);
-    COMMS_ASSERT(iter != m_ops.end());
-    if (iter == m_ops.end()) {
+    auto opsIdx = op->opsIdx();
+    COMMS_ASSERT(opsIdx < m_ops.size());
+    COMMS_ASSERT(m_ops[opsIdx] == op);
+    if ((m_ops.size() <= opsIdx) || (m_ops[opsIdx] != op)) {
         return;
     }
 
-    *iter = nullptr;
+    m_ops[opsIdx] = nullptr;
     m_opsDeleted = true;
 
-    using ExtraCompleteFunc = void (ClientImpl::*)(const op::Op*);
-    static const ExtraCompleteFunc Map[] = {
-        /* Type_Search */ &ClientImpl::opComplete_Search,
-        /* Type_Connect */ &ClientImpl::opComplete_Connect,
-        /* Type_KeepAlive */ &ClientImpl::opComplete_KeepAlive,
-        /* Type_Disconnect */ &ClientImpl::opComplete_Disconnect,
-        /* Type_Subscribe */ &ClientImpl::opComplete_Subscribe,
-        /* Type_Unsubscribe */ &ClientImpl::opComplete_Unsubscribe,
-        /* Type_Send */ &ClientImpl::opComplete_Send,
-        /* Type_Will */ &ClientImpl::opComplete_Will,
-    };
-    static const std::size_t MapSize = std::extent<decltype(Map)>::value;
-    static_assert(MapSize == op::Op::Type_NumOfValues);
-
-    auto idx = static_cast<unsigned>(op->type());
-    COMMS_ASSERT(idx < MapSize);
-    if (MapSize <= idx) {
-        return;
+    if (op->type() != op::Op::Type_KeepAlive) {
+        // The keep alive operation lives as long as the connection
+        stats().opCompleted(op->statsInfo(), static_cast<unsigned>(op->type()), m_clientState.m_timestamp);
     }
 
-    auto func = Map[idx];
-    (this->*func)(op);
+    // Direct calls allow inlining of the type specific completion
+    switch (op->type()) {
+        case op::Op::Type_Search:
+            opComplete_Search(op);
+            break;
+        case op::Op::Type_Connect:
+            opComplete_Connect(op);
+            break;
+        case op::Op::Type_KeepAlive:
+            opComplete_KeepAlive(op);
+            break;
+        case op::Op::Type_Disconnect:
+            opComplete_Disconnect(op);
+            break;
+        case op::Op::Type_Subscribe:
+            opComplete_Subscribe(op);
+            break;
+        case op::Op::Type_Unsubscribe:
+            opComplete_Unsubscribe(op);
+            break;
+        case op::Op::Type_Send:
+            opComplete_Send(op);
+            break;
+        case op::Op::Type_Will:
+            opComplete_Will(op);
+            break;
+        default:
+            COMMS_ASSERT(false); // Should not happen
+            break;
+    }
 }
 
 void ClientImpl::gatewayConnected()
@@ -1390,79 +1715,147 @@ void ClientImpl::storeInRegTopic(const char* topic, CC_MqttsnTopicId topicId)
 {
     COMMS_ASSERT(topic != nullptr);
     auto& map = m_reuseState.m_inRegTopics;
-    auto iter = findInRegTopicInfoInternal(topicId, map);
-    if ((iter != map.end()) && (iter->m_topicId == topicId)) {
-        iter->m_topic = topic;
-        iter->m_timestamp = m_clientState.m_timestamp;
-        return;
-    }
+    auto* info = map.findTopicId(topicId);
+    if (info != nullptr) {
+        if (info->m_topic == topic) {
+            map.touch(*info);
+            return;
+        }
 
-    if (removeLeastRecentlyUsedRegTopicInfoIfNeeded(map, m_clientState.m_inRegTopicsLimit)) {
-        iter = findInRegTopicInfoInternal(topicId, map); // The location can change after erase
+        map.erase(*info); // The topic is the lookup key as well, re-insert
     }
 
-    map.insert(iter, FullRegTopicInfo{m_clientState.m_timestamp, topic, topicId});
+    map.insert(topic, topicId, m_clientState.m_inRegTopicsLimit);
 }
 
 bool ClientImpl::removeInRegTopic(const char* topic, CC_MqttsnTopicId topicId)
 {
     auto& map = m_reuseState.m_inRegTopics;
+    RegTopicInfo* info = nullptr;
     if (op::Op::isValidTopicId(topicId)) {
-        auto iter = findInRegTopicInfoInternal(topicId, map);
-        if ((iter != map.end()) && (iter->m_topicId == topicId)) {
-            map.erase(iter);
-            return true;
-        }
-
-        return false;
+        info = map.findTopicId(topicId);
     }
-
-    if (topic == nullptr) {
-        return false;
+    else if (topic != nullptr) {
+        info = map.findTopic(topic);
     }
 
-    auto iter = findInRegTopicInfoInternal(topic, map);
-    if (iter == map.end()) {
+    if (info == nullptr) {
         return false;
     }
 
-    map.erase(iter);
+    map.erase(*info);
     return true;
 }
 
 CC_MqttsnTopicId ClientImpl::findInRegTopicId(const char* topic)
 {
-    auto& map = m_reuseState.m_inRegTopics;
-    auto iter = findInRegTopicInfoInternal(topic, map);
-    if ((iter == map.end()) || (iter->m_topic != topic)) {
+    auto* info = m_reuseState.m_inRegTopics.findTopic(topic);
+    if (info == nullptr) {
         return 0;
     }
 
-    return iter->m_topicId;
+    return info->m_topicId;
 }
 
 void ClientImpl::storeOutRegTopic(const char* topic, CC_MqttsnTopicId topicId)
 {
     COMMS_ASSERT(topic != nullptr);
     auto& map = m_reuseState.m_outRegTopics;
-    auto iter = findOutRegTopicInfoInternal(topic, map);
-    if ((iter != map.end()) && (iter->m_topic == topic)) {
-        iter->m_topicId = topicId;
-        iter->m_timestamp = m_clientState.m_timestamp;
-        return;
+    auto* info = map.findTopic(topic);
+    if (info != nullptr) {
+        if (info->m_topicId == topicId) {
+            map.touch(*info);
+            return;
+        }
+
+        map.erase(*info); // The topic ID is the lookup key as well, re-insert
     }
 
-    if (removeLeastRecentlyUsedRegTopicInfoIfNeeded(map, m_clientState.m_outRegTopicsLimit)) {
-        iter = findOutRegTopicInfoInternal(topic, map); // The location can change after erase
+    // Every stored topic gets its own generation, the prepared topics referring to
+    // the discarded or other topics are not affected.
+    ++m_clientState.m_outRegTopicsGen;
+    if (m_clientState.m_outRegTopicsGen == 0U) {
+        // Wrap around, 0 is never assigned
+        ++m_clientState.m_outRegTopicsGen;
     }
 
-    map.insert(iter, FullRegTopicInfo{m_clientState.m_timestamp, topic, topicId});
+    map.insert(topic, topicId, m_clientState.m_outRegTopicsLimit, m_clientState.m_outRegTopicsGen);
+}
+
+bool ClientImpl::resolvePreparedTopic(CC_MqttsnPreparedTopic& prepared)
+{
+    COMMS_ASSERT(prepared.m_topic != nullptr);
+    using TopicIdType = PublishMsg::Field_flags::Field_topicIdType::ValueType;
+    if ((prepared.m_topicId != 0U) &&
+        (prepared.m_topicIdType != static_cast<unsigned>(TopicIdType::Normal))) {
+        // Short topic name
+        return true;
+    }
+
+    auto& map = m_reuseState.m_outRegTopics;
+    if (prepared.m_topicId != 0U) {
+        // The registration the cached topic ID belongs to is still stored,
+        // the topic string doesn't need to be looked up.
+        auto* info = map.findTopicId(prepared.m_topicId, prepared.m_generation);
+        if (info != nullptr) {
+            map.touch(*info);
+            return true;
+        }
+    }
+
+    prepared.m_topicId = findOutRegTopicId(prepared.m_topic);
+    if (prepared.m_topicId == 0U) {
+        // Requires registration, only the known topic IDs are cached
+        return false;
+    }
+
+    auto* info = map.findTopic(prepared.m_topic);
+    COMMS_ASSERT(info != nullptr);
+    prepared.m_generation = map.stamp(*info);
+    return true;
+}
+
+CC_MqttsnTopicId ClientImpl::findOutRegTopicId(const char* topic)
+{
+    COMMS_ASSERT(topic != nullptr);
+    auto& map = m_reuseState.m_outRegTopics;
+    auto* info = map.findTopic(topic);
+    if (info != nullptr) {
+        map.touch(*info);
+        return info->m_topicId;
+    }
+
+    // The topic may have been registered by the gateway
+    auto topicId = findInRegTopicId(topic);
+    if (topicId != 0U) {
+        storeOutRegTopic(topic, topicId);
+    }
+
+    return topicId;
+}
+
+unsigned ClientImpl::currentRetryPeriod() const
+{
+    if (!m_configState.m_adaptiveRetryPeriod) {
+        return m_configState.m_retryPeriod;
+    }
+
+    return m_clientState.m_rttEstimator.retryPeriod(m_configState.m_retryPeriod);
 }
 
 void ClientImpl::doApiEnter()
 {
     ++m_apiEnterCount;
-    if ((m_apiEnterCount > 1U) || (m_cancelNextTickWaitCb == nullptr)) {
+    if (m_apiEnterCount > 1U) {
+        return;
+    }
+
+    if (m_clockCb != nullptr) {
+        readClock();
+        return;
+    }
+
+    if (m_cancelNextTickWaitCb == nullptr) {
         return;
     }
 
@@ -1490,11 +1883,64 @@ void ClientImpl::doApiExit()
         return;
     }
 
+    if (m_clockCb != nullptr) {
+        programNextTick();
+        return;
+    }
+
+    auto nextWait = m_timerMgr.getMinWait();
+    if (nextWait == 0U) {
+        return;
+    }
+
+    m_nextTickProgramCb(m_nextTickProgramData, nextWait);
+}
+
+void ClientImpl::readClock()
+{
+    COMMS_ASSERT(m_clockCb != nullptr);
+    auto now = static_cast<std::uint64_t>(m_clockCb(m_clockData));
+    if (!m_clockStarted) {
+        m_clockStarted = true;
+        m_lastClockMs = now;
+        return;
+    }
+
+    COMMS_ASSERT(m_lastClockMs <= now);
+    if (now <= m_lastClockMs) {
+        return;
+    }
+
+    auto elapsed = now - m_lastClockMs;
+    m_lastClockMs = now;
+    m_clientState.m_timestamp += elapsed;
+
+    static constexpr std::uint64_t MaxTick = std::numeric_limits<unsigned>::max();
+    while (elapsed > 0U) {
+        auto tickMs = std::min(elapsed, MaxTick);
+        m_timerMgr.tick(static_cast<unsigned>(tickMs));
+        elapsed -= tickMs;
+    }
+}
+
+void ClientImpl::programNextTick()
+{
+    COMMS_ASSERT(m_clockCb != nullptr);
+    COMMS_ASSERT(m_nextTickProgramCb != nullptr);
     auto nextWait = m_timerMgr.getMinWait();
     if (nextWait == 0U) {
+        // No active timers, let the programmed one (if any) expire
+        // to avoid its cancellation.
+        return;
+    }
+
+    auto deadline = m_clientState.m_timestamp + nextWait;
+    if ((m_programmedDeadline != NoDeadline) && (m_programmedDeadline <= deadline)) {
+        // The programmed timer expires first, re-evaluate on its tick
         return;
     }
 
+    m_programmedDeadline = deadline;
     m_nextTickProgramCb(m_nextTickProgramData, nextWait);
 }
 
@@ -1511,7 +1957,7 @@ void ClientImpl::createKeepAliveOpIfNeeded()
     }
 
     COMMS_ASSERT(m_ops.size() < m_ops.max_size());
-    m_ops.push_back(ptr.get());
+    addOp(ptr.get());
     m_keepAliveOps.push_back(std::move(ptr));
 }
 
@@ -1532,18 +1978,129 @@ void ClientImpl::cleanOps()
         return;
     }
 
-    m_ops.erase(
-        std::remove_if(
-            m_ops.begin(), m_ops.end(),
-            [](auto* op)
-            {
-                return op == nullptr;
-            }),
-        m_ops.end());
+    // Preserve the order of the remaining ops while updating
+    // their stored indices.
+    std::size_t count = 0U;
+    for (auto* op : m_ops) {
+        if (op == nullptr) {
+            continue;
+        }
+
+        op->setOpsIdx(count);
+        m_ops[count] = op;
+        ++count;
+    }
 
+    m_ops.resize(count);
     m_opsDeleted = false;
 }
 
+template <typename TFunc>
+void ClientImpl::processFramesInternal(unsigned count, TFunc&& func)
+{
+    for (auto idx = 0U; idx < count; ++idx) {
+        func(idx);
+
+        if (m_apiEnterCount == 1U) {
+            // Release slots of the completed operations to allow
+            // preparation of the new ones while processing the rest of the frames.
+            cleanOps();
+        }
+    }
+}
+
+template <typename TMsg, typename TList>
+void ClientImpl::dispatchToOps(TMsg& msg, TList& ops)
+{
+    // All the operation classes are final, calling the handler with the
+    // actual message type is resolved at compile time and doesn't
+    // require double virtual dispatch.
+    for (auto& opPtr : ops) {
+        opPtr->handle(msg);
+    }
+}
+
+template <typename TMsg>
+void ClientImpl::dispatchToOp(TMsg& msg, op::Op& op)
+{
+    // Only the operations below allocate packet IDs
+    switch (op.type()) {
+        case op::Op::Type_Subscribe:
+            static_cast<op::SubscribeOp&>(op).handle(msg);
+            break;
+        case op::Op::Type_Unsubscribe:
+            static_cast<op::UnsubscribeOp&>(op).handle(msg);
+            break;
+        case op::Op::Type_Send:
+            static_cast<op::SendOp&>(op).handle(msg);
+            break;
+        default:
+            COMMS_ASSERT(false); // Should not happen
+            break;
+    }
+}
+
+template <typename TMsg>
+bool ClientImpl::dispatchToKeepAliveOps(TMsg& msg)
+{
+    if (m_sessionState.m_lastOrigin != CC_MqttsnDataOrigin_ConnectedGw) {
+        return false;
+    }
+
+    if (m_sessionState.m_disconnecting) {
+        return false;
+    }
+
+    // The keep alive operation monitors all the incoming messages
+    dispatchToOps(msg, m_keepAliveOps);
+
+    // After message dispatching the whole session may be in terminating state
+    return !m_sessionState.m_disconnecting;
+}
+
+template <typename TMsg>
+void ClientImpl::dispatchToMsgIdOp(TMsg& msg, std::uint16_t msgId)
+{
+    if (!dispatchToKeepAliveOps(msg)) {
+        return;
+    }
+
+    // Only the operation that allocated the packet ID is expected
+    // to handle the acknowledgement.
+    auto* op = m_clientState.m_msgIdOps.find(msgId);
+    if (op == nullptr) {
+        return;
+    }
+
+    dispatchToOp(msg, *op);
+}
+
+template <typename TMsg, typename TList>
+void ClientImpl::dispatchToSingleOp(TMsg& msg, TList& ops)
+{
+    if (!dispatchToKeepAliveOps(msg)) {
+        return;
+    }
+
+    if (ops.empty()) {
+        return;
+    }
+
+    // Preparation of the operations of the relevant types is rejected
+    // while another one is in progress.
+    COMMS_ASSERT(ops.size() == 1U);
+    COMMS_ASSERT(ops.front());
+    ops.front()->handle(msg);
+}
+
+void ClientImpl::addOp(op::Op* op)
+{
+    COMMS_ASSERT(op != nullptr);
+    COMMS_ASSERT(m_ops.size() < m_ops.max_size());
+    op->setOpsIdx(m_ops.size());
+    m_ops.push_back(op);
+}
+
 void ClientImpl::errorLogInternal(const char* msg)
 {
     if constexpr (Config::HasErrorLog) {
@@ -1555,20 +2112,94 @@ void ClientImpl::errorLogInternal(const char* msg)
     }
 }
 
+bool ClientImpl::processDataInternal(const std::uint8_t* iter, unsigned len, CC_MqttsnDataOrigin origin)
+{
+    m_sessionState.m_lastOrigin = origin;
+    ProtFrame::MsgPtr msgPtr;
+    auto es = comms::processSingleWithDispatch(iter, len, m_frame, msgPtr, *this);
+    if (es != comms::ErrorStatus::Success) {
+        stats().decodeFailure(len);
+        errorLog("Failed to decode the received message");
+        return false;
+    }
+
+    COMMS_ASSERT(msgPtr);
+    stats().messageReceived(static_cast<unsigned>(msgPtr->getId()), len);
+    return true;
+}
+
+void ClientImpl::messageSentInternal(const ProtMessage& msg, std::size_t len)
+{
+    stats().messageSent(static_cast<unsigned>(msg.getId()), len);
+    for (auto& opPtr : m_keepAliveOps) {
+        opPtr->messageSent();
+    }
+}
+
+void ClientImpl::reportOutputInternal(const ProtMessage& msg, const std::uint8_t* buf, unsigned bufLen, const std::uint8_t* payload, unsigned payloadLen, unsigned broadcastRadius)
+{
+    if (m_sendOutputSegmentsCb != nullptr) {
+        CC_MqttsnOutputSegment segments[] = {
+            {buf, bufLen},
+            {payload, payloadLen},
+        };
+
+        auto count = static_cast<unsigned>(std::size(segments));
+        if (payloadLen == 0U) {
+            count = 1U;
+        }
+
+        m_sendOutputSegmentsCb(m_sendOutputSegmentsData, segments, count, broadcastRadius);
+        messageSentInternal(msg, static_cast<std::size_t>(bufLen) + payloadLen);
+        return;
+    }
+
+    COMMS_ASSERT(payloadLen == 0U);
+    COMMS_ASSERT(m_sendOutputDataCb != nullptr);
+    m_sendOutputDataCb(m_sendOutputDataData, buf, bufLen, broadcastRadius);
+    messageSentInternal(msg, bufLen);
+}
+
 CC_MqttsnErrorCode ClientImpl::initInternal()
 {
     auto guard = apiEnter();
 
-    if ((m_sendOutputDataCb == nullptr) ||
+    bool hasOutputBufferCallbacks =
+        (m_getOutputBufferCb != nullptr) ||
+        (m_commitOutputBufferCb != nullptr);
+
+    if (hasOutputBufferCallbacks) {
+        bool hasAllOutputBufferCallbacks =
+            (m_getOutputBufferCb != nullptr) &&
+            (m_commitOutputBufferCb != nullptr);
+
+        if (!hasAllOutputBufferCallbacks) {
+            errorLog("Hasn't set all output buffer callbacks");
+            return CC_MqttsnErrorCode_NotIntitialized;
+        }
+    }
+
+    bool hasOutputCallback =
+        (m_sendOutputDataCb != nullptr) ||
+        (m_sendOutputSegmentsCb != nullptr) ||
+        hasOutputBufferCallbacks;
+
+    if ((!hasOutputCallback) ||
         (m_messageReceivedReportCb == nullptr) ||
         (m_gatewayDisconnectedReportCb == nullptr)) {
         errorLog("Hasn't set all must have callbacks");
         return CC_MqttsnErrorCode_NotIntitialized;
     }
 
+    if ((m_clockCb != nullptr) && (m_nextTickProgramCb == nullptr)) {
+        errorLog("Hasn't set next tick program callback to use with the clock");
+        return CC_MqttsnErrorCode_NotIntitialized;
+    }
+
     bool hasTimerCallbacks =
-        (m_nextTickProgramCb != nullptr) ||
-        (m_cancelNextTickWaitCb != nullptr);
+        (m_clockCb == nullptr) &&
+        ((m_nextTickProgramCb != nullptr) ||
+         (m_cancelNextTickWaitCb != nullptr));
 
     if (hasTimerCallbacks) {
         bool hasAllTimerCallbacks =
@@ -1678,13 +2309,7 @@ void ClientImpl::opComplete_Unsubscribe(const op::Op* op)
 void ClientImpl::opComplete_Send(const op::Op* op)
 {
     eraseFromList(op, m_sendOps);
-
-    if (m_sendOps.empty()) {
-        return;
-    }
-
-    COMMS_ASSERT(m_sendOps.front());
-    m_sendOps.front()->resume();
+    resumeSendOps();
 }
 
 void ClientImpl::opComplete_Will([[maybe_unused]] const op::Op* op)
@@ -1694,6 +2319,33 @@ void ClientImpl::opComplete_Will([[maybe_unused]] const op::Op* op)
 #endif // #if CC_MQTTSN_CLIENT_HAS_WILL
 }
 
+void ClientImpl::resumeSendOps()
+{
+    // The resumed operation may complete right away (QoS0) and
+    // modify the list, re-evaluate on every iteration.
+    while (true) {
+        auto iter =
+            std::find_if(
+                m_sendOps.begin(), m_sendOps.end(),
+                [](auto& opPtr)
+                {
+                    COMMS_ASSERT(opPtr);
+                    return opPtr->isSuspended();
+                });
+
+        if (iter == m_sendOps.end()) {
+            return;
+        }
+
+        auto inflightCount = static_cast<std::size_t>(std::distance(m_sendOps.begin(), iter));
+        if (m_configState.m_inflightPubsLimit <= inflightCount) {
+            return;
+        }
+
+        (*iter)->resume();
+    }
+}
+
 void ClientImpl::finaliseSupUnsubOp()
 {
     if (m_subscribeOps.empty() && m_unsubscribeOps.empty()) {
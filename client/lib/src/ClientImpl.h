@@ -10,12 +10,14 @@
 #pragma once
 
 #include "ClientState.h"
+#include "ClientStats.h"
 #include "ConfigState.h"
 #include "ExtConfig.h"
 #include "ObjAllocator.h"
 #include "ObjListType.h"
 #include "ProtocolDefs.h"
 #include "ReuseState.h"
+#include "RxRing.h"
 #include "SessionState.h"
 #include "TimerMgr.h"
 
@@ -31,10 +33,15 @@
 
 #include "cc_mqttsn_client/common.h"
 
+#include <cstdint>
+#include <limits>
+
 namespace cc_mqttsn_client
 {
 
-class ClientImpl final : public ProtMsgHandler
+// The statistics are a private base class rather than a data member
+// to occupy no space when excluded from the build.
+class ClientImpl final : public ProtMsgHandler, private ClientStats
 {
     using Base = ProtMsgHandler;
 
@@ -67,6 +74,14 @@ public:
     // -------------------- API Calls -----------------------------
     void tick(unsigned ms);
     void processData(const std::uint8_t* iter, unsigned len, CC_MqttsnDataOrigin origin);
+    unsigned processDataBatch(CC_MqttsnInputData* inputs, unsigned count);
+    CC_MqttsnErrorCode rxRingPush(const std::uint8_t* buf, unsigned bufLen, CC_MqttsnDataOrigin origin)
+    {
+        // Invoked from the interrupt context, must not touch anything else
+        return m_rxRing.push(buf, bufLen, origin);
+    }
+
+    unsigned rxRingDrain();
 
     op::SearchOp* searchPrepare(CC_MqttsnErrorCode* ec);
     op::ConnectOp* connectPrepare(CC_MqttsnErrorCode* ec);
@@ -80,7 +95,14 @@ public:
     std::size_t getOutgoingRegTopicsLimit() const;
     CC_MqttsnErrorCode setIncomingRegTopicsLimit(std::size_t limit);
     std::size_t getIncomingRegTopicsLimit() const;
+    CC_MqttsnErrorCode prepareTopic(const char* topic, CC_MqttsnPreparedTopic* prepared);
+    CC_MqttsnErrorCode publishQos0(const CC_MqttsnPublishConfig* config, CC_MqttsnPreparedTopic* prepared = nullptr);
+    unsigned publishBatch(CC_MqttsnPublishRequest* requests, unsigned count);
+    CC_MqttsnErrorCode setInflightPubsLimit(unsigned limit);
+    CC_MqttsnErrorCode setOpsSlabLimit(unsigned limit);
     CC_MqttsnErrorCode asleepCheckMessages();
+    CC_MqttsnErrorCode getStats(CC_MqttsnClientStats* stats) const;
+    CC_MqttsnErrorCode resetStats();
 
     void setNextTickProgramCallback(CC_MqttsnNextTickProgramCb cb, void* data)
     {
@@ -98,6 +120,14 @@ public:
         }
     }
 
+    void setClockCallback(CC_MqttsnClockCb cb, void* data)
+    {
+        m_clockCb = cb;
+        m_clockData = data;
+        m_clockStarted = false;
+        m_programmedDeadline = NoDeadline;
+    }
+
     void setSendOutputDataCallback(CC_MqttsnSendOutputDataCb cb, void* data)
     {
         if (cb != nullptr) {
@@ -106,6 +136,34 @@ public:
         }
     }
 
+    void setSendOutputSegmentsCallback(CC_MqttsnSendOutputSegmentsCb cb, void* data)
+    {
+        if ((cb == nullptr) && (m_sendOutputDataCb == nullptr) && (m_getOutputBufferCb == nullptr)) {
+            // Don't remain without any output callback
+            return;
+        }
+
+        m_sendOutputSegmentsCb = cb;
+        m_sendOutputSegmentsData = data;
+    }
+
+    void setOutputBufferCallbacks(CC_MqttsnGetOutputBufferCb getBufCb, CC_MqttsnCommitOutputBufferCb commitCb, void* data)
+    {
+        if ((getBufCb == nullptr) != (commitCb == nullptr)) {
+            // Incomplete pair
+            return;
+        }
+
+        if ((getBufCb == nullptr) && (m_sendOutputDataCb == nullptr) && (m_sendOutputSegmentsCb == nullptr)) {
+            // Don't remain without any output callback
+            return;
+        }
+
+        m_getOutputBufferCb = getBufCb;
+        m_commitOutputBufferCb = commitCb;
+        m_outputBufferData = data;
+    }
+
     void setGatewayStatusReportCallback(CC_MqttsnGwStatusReportCb cb, void* data)
     {
         if (cb != nullptr) {
@@ -151,21 +209,38 @@ public:
     virtual void handle(GwinfoMsg& msg) override;
 #endif // #if CC_MQTTSN_CLIENT_HAS_GATEWAY_DISCOVERY
 
-    virtual void handle(RegisterMsg& msg) override;
-    virtual void handle(PublishMsg& msg) override;
+    virtual void handle(ConnackMsg& msg) override;
+
+#if CC_MQTTSN_CLIENT_HAS_WILL
+    virtual void handle(WilltopicreqMsg& msg) override;
+    virtual void handle(WillmsgreqMsg& msg) override;
+    virtual void handle(WilltopicrespMsg& msg) override;
+    virtual void handle(WillmsgrespMsg& msg) override;
+#endif // #if CC_MQTTSN_CLIENT_HAS_WILL
+
+    virtual void handle(InRegisterMsg& msg) override;
+    virtual void handle(RegackMsg& msg) override;
+    virtual void handle(InPublishMsg& msg) override;
     virtual void handle(PubackMsg& msg) override;
 
 #if CC_MQTTSN_CLIENT_MAX_QOS >= 2
     virtual void handle(PubrelMsg& msg) override;
+    virtual void handle(PubrecMsg& msg) override;
+    virtual void handle(PubcompMsg& msg) override;
 #endif // #if CC_MQTTSN_CLIENT_MAX_QOS >= 2
 
+    virtual void handle(SubackMsg& msg) override;
+    virtual void handle(UnsubackMsg& msg) override;
+
     virtual void handle(PingreqMsg& msg) override;
+    virtual void handle(PingrespMsg& msg) override;
     virtual void handle(DisconnectMsg& msg) override;
     virtual void handle(ProtMessage& msg) override;
 
     // -------------------- Ops Access API -----------------------------
 
     CC_MqttsnErrorCode sendMessage(const ProtMessage& msg, unsigned broadcastRadius = 0);
+    CC_MqttsnErrorCode sendMessage(const ProtMessage& msg, const std::uint8_t* payload, unsigned payloadLen, bool lentPayload, unsigned broadcastRadius = 0);
     void opComplete(const op::Op* op);
     void gatewayConnected();
     void gatewayDisconnected(
@@ -177,12 +252,20 @@ public:
     bool removeInRegTopic(const char* topic, CC_MqttsnTopicId topicId);
     CC_MqttsnTopicId findInRegTopicId(const char* topic);
     void storeOutRegTopic(const char* topic, CC_MqttsnTopicId topicId);
+    CC_MqttsnTopicId findOutRegTopicId(const char* topic);
+    bool resolvePreparedTopic(CC_MqttsnPreparedTopic& prepared);
+    unsigned currentRetryPeriod() const;
 
     TimerMgr& timerMgr()
     {
         return m_timerMgr;
     }
 
+    op::SendOpStorageAlloc& sendOpStoragesAlloc()
+    {
+        return m_sendOpStoragesAlloc;
+    }
+
     ConfigState& configState()
     {
         return m_configState;
@@ -218,6 +301,16 @@ public:
         return m_reuseState;
     }
 
+    ClientStats& stats()
+    {
+        return *this;
+    }
+
+    const ClientStats& stats() const
+    {
+        return *this;
+    }
+
     inline void errorLog(const char* msg)
     {
         if constexpr (Config::HasErrorLog) {
@@ -265,16 +358,43 @@ private:
 #endif // #if CC_MQTTSN_CLIENT_HAS_WILL
 
     using OpPtrsList = ObjListType<op::Op*, ExtConfig::OpsLimit>;
+    static constexpr ClientState::Timestamp NoDeadline = std::numeric_limits<ClientState::Timestamp>::max();
     using OutputBuf = ObjListType<std::uint8_t, ExtConfig::MaxOutputPacketSize>;
 
     void doApiEnter();
     void doApiExit();
+    void readClock();
+    void programNextTick();
     void createKeepAliveOpIfNeeded();
     void terminateOps(CC_MqttsnAsyncOpStatus status);
     void cleanOps();
+
+    template <typename TMsg, typename TList>
+    static void dispatchToOps(TMsg& msg, TList& ops);
+
+    template <typename TMsg>
+    static void dispatchToOp(TMsg& msg, op::Op& op);
+
+    template <typename TMsg>
+    bool dispatchToKeepAliveOps(TMsg& msg);
+
+    template <typename TMsg>
+    void dispatchToMsgIdOp(TMsg& msg, std::uint16_t msgId);
+
+    template <typename TMsg, typename TList>
+    void dispatchToSingleOp(TMsg& msg, TList& ops);
+
+    void addOp(op::Op* op);
     void errorLogInternal(const char* msg);
     CC_MqttsnErrorCode initInternal();
     bool verifyPubTopicInternal(const char* topic, bool outgoing);
+    bool processDataInternal(const std::uint8_t* iter, unsigned len, CC_MqttsnDataOrigin origin);
+
+    template <typename TFunc>
+    void processFramesInternal(unsigned count, TFunc&& func);
+
+    void messageSentInternal(const ProtMessage& msg, std::size_t len);
+    void reportOutputInternal(const ProtMessage& msg, const std::uint8_t* buf, unsigned bufLen, const std::uint8_t* payload, unsigned payloadLen, unsigned broadcastRadius);
 
     void opComplete_Search(const op::Op* op);
     void opComplete_Connect(const op::Op* op);
@@ -286,6 +406,7 @@ private:
     void opComplete_Will(const op::Op* op);
 
     void finaliseSupUnsubOp();
+    void resumeSendOps();
     void monitorGatewayExpiry();
     void gwExpiryTimeout();
     void reportGwStatus(CC_MqttsnGwStatus status, const ClientState::GwInfo& info);
@@ -302,9 +423,19 @@ private:
     CC_MqttsnCancelNextTickWaitCb m_cancelNextTickWaitCb = nullptr;
     void* m_cancelNextTickWaitData = nullptr;
 
+    CC_MqttsnClockCb m_clockCb = nullptr;
+    void* m_clockData = nullptr;
+
     CC_MqttsnSendOutputDataCb m_sendOutputDataCb = nullptr;
     void* m_sendOutputDataData = nullptr;
 
+    CC_MqttsnSendOutputSegmentsCb m_sendOutputSegmentsCb = nullptr;
+    void* m_sendOutputSegmentsData = nullptr;
+
+    CC_MqttsnGetOutputBufferCb m_getOutputBufferCb = nullptr;
+    CC_MqttsnCommitOutputBufferCb m_commitOutputBufferCb = nullptr;
+    void* m_outputBufferData = nullptr;
+
     CC_MqttsnGwStatusReportCb m_gatewayStatusReportCb = nullptr;
     void* m_gatewayStatusReportData = nullptr;
 
@@ -333,6 +464,7 @@ private:
     OutputBuf m_buf;
 
     ProtFrame m_frame;
+    RxRing m_rxRing;
 
 #if CC_MQTTSN_CLIENT_HAS_GATEWAY_DISCOVERY
     SearchOpAlloc m_searchOpAlloc;
@@ -354,6 +486,8 @@ private:
     UnsubscribeOpAlloc m_unsubscribeOpsAlloc;
     UnsubscribeOpsList m_unsubscribeOps;
 
+    // Must outlive the publish operations referencing the storages
+    op::SendOpStorageAlloc m_sendOpStoragesAlloc;
     SendOpAlloc m_sendOpsAlloc;
     SendOpsList m_sendOps;
 
@@ -363,7 +497,10 @@ private:
 #endif // #if CC_MQTTSN_CLIENT_HAS_WILL
 
     OpPtrsList m_ops;
+    std::uint64_t m_lastClockMs = 0U;
+    ClientState::Timestamp m_programmedDeadline = NoDeadline;
     unsigned m_pendingGwinfoBroadcastRadius = 0U;
+    bool m_clockStarted = false;
     bool m_opsDeleted = false;
     bool m_preparationLocked = false;
 };
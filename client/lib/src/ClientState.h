@@ -10,8 +10,11 @@
 #pragma once
 
 #include "ExtConfig.h"
+#include "MsgIdOpsMap.h"
 #include "ObjListType.h"
+#include "PacketIdAllocator.h"
 #include "ProtocolDefs.h"
+#include "RttEstimator.h"
 
 #include "cc_mqttsn_client/common.h"
 
@@ -35,17 +38,18 @@ struct ClientState
         std::uint8_t m_gwId = 0;
     };
 
-    using PacketIdsList = ObjListType<std::uint16_t, ExtConfig::PacketIdsLimit>;
     using GwInfosList = ObjListType<GwInfo, ExtConfig::GatewayInfoxMaxLimit, ExtConfig::HasGatewayDiscovery>;
 
     static constexpr unsigned DefaultKeepAlive = 60;
 
     GwInfosList m_gwInfos;
-    PacketIdsList m_allocatedPacketIds;
+    PacketIdAllocator m_packetIds;
+    OpsMsgIdMap m_msgIdOps;
     Timestamp m_timestamp = 0U;
+    RttEstimator m_rttEstimator;
     std::size_t m_outRegTopicsLimit = std::numeric_limits<std::size_t>::max();
     std::size_t m_inRegTopicsLimit = std::numeric_limits<std::size_t>::max();
-    std::uint16_t m_lastPacketId = 0U;
+    unsigned m_outRegTopicsGen = 0U; // Generation assigned to the last stored registered outgoing topic
     bool m_initialized = false;
     bool m_firstConnect = true;
     // bool m_networkDisconnected = false;
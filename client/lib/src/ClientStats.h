@@ -0,0 +1,163 @@
+//
+// Copyright 2024 - 2026 (C). Alex Robenko. All rights reserved.
+//
+// SPDX-License-Identifier: MPL-2.0
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include "Config.h"
+
+#include "comms/Assert.h"
+
+#include "cc_mqttsn_client/common.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+namespace cc_mqttsn_client
+{
+
+// All the functions are empty when the statistics are excluded from the build,
+// expected to be optimized away by the compiler.
+template <bool THasStats>
+class ClientStatsImpl
+{
+public:
+    using Timestamp = std::uint64_t;
+
+    struct OpInfo
+    {
+    };
+
+    void messageSent([[maybe_unused]] unsigned msgType, [[maybe_unused]] std::size_t len) {}
+    void messageReceived([[maybe_unused]] unsigned msgType, [[maybe_unused]] std::size_t len) {}
+    void decodeFailure([[maybe_unused]] std::size_t len) {}
+    void unsubscribedMessageDropped() {}
+    void opMessageSent([[maybe_unused]] OpInfo& info, [[maybe_unused]] Timestamp timestamp) {}
+    void opRetry([[maybe_unused]] unsigned opType) {}
+    void opTimeout([[maybe_unused]] unsigned opType) {}
+    void opCompleted([[maybe_unused]] const OpInfo& info, [[maybe_unused]] unsigned opType, [[maybe_unused]] Timestamp timestamp) {}
+    void fill([[maybe_unused]] CC_MqttsnClientStats& stats) const {}
+    void reset() {}
+};
+
+template <>
+class ClientStatsImpl<true>
+{
+public:
+    using Timestamp = std::uint64_t;
+
+    struct OpInfo
+    {
+        Timestamp m_startTimestamp = 0U;
+        bool m_started = false;
+    };
+
+    void messageSent(unsigned msgType, std::size_t len)
+    {
+        if (msgType < CC_MQTTSN_CLIENT_STATS_MSG_TYPES_LIMIT) {
+            ++m_stats.m_sentMsgs[msgType];
+        }
+
+        m_stats.m_sentBytes += len;
+    }
+
+    void messageReceived(unsigned msgType, std::size_t len)
+    {
+        if (msgType < CC_MQTTSN_CLIENT_STATS_MSG_TYPES_LIMIT) {
+            ++m_stats.m_receivedMsgs[msgType];
+        }
+
+        m_stats.m_receivedBytes += len;
+    }
+
+    void decodeFailure(std::size_t len)
+    {
+        ++m_stats.m_decodeFailures;
+        m_stats.m_receivedBytes += len;
+    }
+
+    void unsubscribedMessageDropped()
+    {
+        ++m_stats.m_droppedUnsubscribed;
+    }
+
+    void opMessageSent(OpInfo& info, Timestamp timestamp)
+    {
+        if (info.m_started) {
+            return;
+        }
+
+        // The latency is measured from the first sent message of the operation
+        info.m_startTimestamp = timestamp;
+        info.m_started = true;
+    }
+
+    void opRetry(unsigned opType)
+    {
+        ++opStats(opType).m_retries;
+    }
+
+    void opTimeout(unsigned opType)
+    {
+        ++opStats(opType).m_timeouts;
+    }
+
+    void opCompleted(const OpInfo& info, unsigned opType, Timestamp timestamp)
+    {
+        if (!info.m_started) {
+            return;
+        }
+
+        auto& stats = opStats(opType);
+        auto latency =
+            static_cast<unsigned>(
+                std::min<Timestamp>(
+                    timestamp - std::min(info.m_startTimestamp, timestamp),
+                    std::numeric_limits<unsigned>::max()));
+
+        if (stats.m_completed == 0U) {
+            stats.m_latencyMinMs = latency;
+            stats.m_latencyMaxMs = latency;
+        }
+
+        ++stats.m_completed;
+        stats.m_latencyTotalMs += latency;
+        stats.m_latencyMinMs = std::min(stats.m_latencyMinMs, latency);
+        stats.m_latencyMaxMs = std::max(stats.m_latencyMaxMs, latency);
+    }
+
+    void fill(CC_MqttsnClientStats& stats) const
+    {
+        stats = m_stats;
+    }
+
+    void reset()
+    {
+        m_stats = CC_MqttsnClientStats();
+    }
+
+private:
+    CC_MqttsnOpStats& opStats(unsigned opType)
+    {
+        static_assert(CC_MqttsnOpType_ValuesLimit == std::extent<decltype(m_stats.m_ops)>::value);
+        COMMS_ASSERT(opType < CC_MqttsnOpType_ValuesLimit);
+        return m_stats.m_ops[std::min(opType, static_cast<unsigned>(CC_MqttsnOpType_ValuesLimit) - 1U)];
+    }
+
+    CC_MqttsnClientStats m_stats = CC_MqttsnClientStats();
+};
+
+static_assert(std::is_empty<ClientStatsImpl<false> >::value);
+static_assert(std::is_empty<ClientStatsImpl<false>::OpInfo>::value);
+
+using ClientStats = ClientStatsImpl<Config::HasStats>;
+
+} // namespace cc_mqttsn_client
@@ -22,15 +22,18 @@ struct ConfigState
     static constexpr unsigned DefaultGwAdvTimeoutMs = 15 * 60 * 1000; //
     static constexpr unsigned DefautlAllowedAdvLosses = 1;
     static constexpr unsigned MaxBroadcastRadius = 255U;
+    static constexpr unsigned DefaultInflightPubsLimit = 1U;
 
     unsigned m_retryPeriod = DefaultResponseTimeoutMs;
     unsigned m_retryCount = DefaultRetryCount;
     unsigned m_broadcastRadius = DefaultBroadcastRadius;
     unsigned m_gwAdvTimeoutMs = DefaultGwAdvTimeoutMs;
     unsigned m_allowedAdvLosses = DefautlAllowedAdvLosses;
+    unsigned m_inflightPubsLimit = DefaultInflightPubsLimit;
     bool m_verifyOutgoingTopic = Config::HasTopicFormatVerification;
     bool m_verifyIncomingTopic = Config::HasTopicFormatVerification;
     bool m_verifySubFilter = Config::HasSubTopicVerification;
+    bool m_adaptiveRetryPeriod = false;
 };
 
 } // namespace cc_mqttsn_client
@@ -54,6 +54,14 @@ struct ExtConfig : public Config
         (WillOpsLimit * WillOpTimers);
     static constexpr unsigned TimersLimit = HasOpsLimit ? MaxTimersLimit : 0U;
 
+    // Amount of the publish operations owning the copy of the topic and / or data,
+    // cannot exceed the amount of the publish operations themselves. When not
+    // configured, the limited publish operations share a single storage.
+    static constexpr unsigned SendOpStoragesLimit =
+        (Config::SendOpStoragesLimit == 0U) ? ((SendOpsLimit == 0U) ? 0U : 1U) :
+        (SendOpsLimit == 0U) ? Config::SendOpStoragesLimit :
+        (Config::SendOpStoragesLimit < SendOpsLimit) ? Config::SendOpStoragesLimit : SendOpsLimit;
+
     static const unsigned MaxOpsLimit =
         ConnectOpsLimit +
         KeepAliveOpsLimit +
@@ -72,6 +80,8 @@ struct ExtConfig : public Config
 
     static const unsigned PacketIdsLimit = HasDynMemAlloc ? 0U : PacketIdsLimitSumTmp;
 
+    static constexpr unsigned RxRingSlotSize = (RxRingFrameSize > 0U) ? RxRingFrameSize : MaxOutputPacketSize;
+
     static_assert(HasDynMemAlloc || (TimersLimit > 0U));
     static_assert(HasDynMemAlloc || (ConnectOpsLimit > 0U));
     static_assert(HasDynMemAlloc || (KeepAliveOpsLimit > 0U));
@@ -0,0 +1,182 @@
+//
+// Copyright 2024 - 2026 (C). Alex Robenko. All rights reserved.
+//
+// SPDX-License-Identifier: MPL-2.0
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include "ExtConfig.h"
+#include "ObjListType.h"
+
+#include "comms/Assert.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+namespace cc_mqttsn_client
+{
+
+namespace op
+{
+
+class Op;
+
+} // namespace op
+
+// Hashed index of the operations by the allocated packet (message) ID,
+// used to route the acknowledgement messages directly to the relevant
+// operation. The elements are kept in slots of the ObjListType and are
+// chained in the buckets by their indices.
+template <unsigned TLimit>
+class MsgIdOpsMap
+{
+public:
+    MsgIdOpsMap()
+    {
+        if constexpr (HasFixedBuckets) {
+            m_buckets.resize(m_buckets.max_size(), InvalidIdx);
+        }
+    }
+
+    std::size_t size() const
+    {
+        return m_count;
+    }
+
+    bool empty() const
+    {
+        return m_count == 0U;
+    }
+
+    op::Op* find(std::uint16_t msgId) const
+    {
+        if (m_buckets.empty()) {
+            return nullptr;
+        }
+
+        auto idx = m_buckets[bucketIdx(msgId)];
+        while (idx != InvalidIdx) {
+            auto& node = m_nodes[idx];
+            if (node.m_msgId == msgId) {
+                return node.m_op;
+            }
+
+            idx = node.m_next;
+        }
+
+        return nullptr;
+    }
+
+    void insert(std::uint16_t msgId, op::Op* op)
+    {
+        COMMS_ASSERT(msgId != 0U);
+        COMMS_ASSERT(op != nullptr);
+        COMMS_ASSERT(find(msgId) == nullptr);
+
+        unsigned idx = m_freeHead;
+        if (idx != InvalidIdx) {
+            m_freeHead = m_nodes[idx].m_next;
+        }
+        else {
+            COMMS_ASSERT(m_nodes.size() < m_nodes.max_size());
+            m_nodes.emplace_back();
+            idx = static_cast<unsigned>(m_nodes.size() - 1U);
+        }
+
+        auto& node = m_nodes[idx];
+        node.m_op = op;
+        node.m_msgId = msgId;
+
+        ++m_count;
+        if constexpr (!HasFixedBuckets) {
+            if (m_buckets.size() < m_count) {
+                rehash(std::max(MinDynBucketsCount, m_count * 2U));
+                return;
+            }
+        }
+
+        link(idx);
+    }
+
+    void erase(std::uint16_t msgId)
+    {
+        if (m_buckets.empty()) {
+            return;
+        }
+
+        auto* link = &m_buckets[bucketIdx(msgId)];
+        while (*link != InvalidIdx) {
+            auto idx = *link;
+            auto& node = m_nodes[idx];
+            if (node.m_msgId != msgId) {
+                link = &node.m_next;
+                continue;
+            }
+
+            *link = node.m_next;
+            node.m_op = nullptr;
+            node.m_msgId = 0U;
+            node.m_next = m_freeHead;
+            m_freeHead = idx;
+            COMMS_ASSERT(0U < m_count);
+            --m_count;
+            return;
+        }
+    }
+
+private:
+    static constexpr unsigned InvalidIdx = std::numeric_limits<unsigned>::max();
+    static constexpr bool HasFixedBuckets = (TLimit > 0U);
+    static constexpr unsigned MinDynBucketsCount = 16U;
+
+    struct Node
+    {
+        op::Op* m_op = nullptr;
+        unsigned m_next = InvalidIdx; // Also used as next in the free list
+        std::uint16_t m_msgId = 0U;
+    };
+
+    using NodesList = ObjListType<Node, TLimit>;
+    using BucketsList = ObjListType<unsigned, TLimit>;
+
+    std::size_t bucketIdx(std::uint16_t msgId) const
+    {
+        // The packet IDs are allocated sequentially, i.e. the modulo
+        // distributes them evenly between the buckets.
+        COMMS_ASSERT(!m_buckets.empty());
+        return static_cast<std::size_t>(msgId) % m_buckets.size();
+    }
+
+    void link(unsigned idx)
+    {
+        auto& node = m_nodes[idx];
+        auto& bucket = m_buckets[bucketIdx(node.m_msgId)];
+        node.m_next = bucket;
+        bucket = idx;
+    }
+
+    void rehash(std::size_t bucketsCount)
+    {
+        m_buckets.assign(bucketsCount, InvalidIdx);
+        for (auto idx = 0U; idx < m_nodes.size(); ++idx) {
+            if (m_nodes[idx].m_op != nullptr) {
+                link(idx);
+            }
+        }
+    }
+
+    NodesList m_nodes;
+    BucketsList m_buckets;
+    unsigned m_freeHead = InvalidIdx;
+    unsigned m_count = 0U;
+};
+
+using OpsMsgIdMap = MsgIdOpsMap<ExtConfig::PacketIdsLimit>;
+
+} // namespace cc_mqttsn_client
@@ -9,17 +9,134 @@
 
 #pragma once
 
+#include "AllocHooks.h"
+
+#include "comms/Assert.h"
 #include "comms/util/alloc.h"
 #include "comms/util/type_traits.h"
 
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
 namespace cc_mqttsn_client
 {
 
+namespace details
+{
+
+// Dynamic allocator of the objects using the allocation hooks. The memory of the
+// released objects can be kept in the slab (intrusive free list) for reuse, which
+// avoids allocator churn and heap fragmentation when the objects of the same
+// fixed size are allocated and released repeatedly.
+template <typename TObj>
+class ObjSlabAlloc
+{
+public:
+    class Deleter
+    {
+    public:
+        Deleter() = default;
+        explicit Deleter(ObjSlabAlloc& alloc) : m_alloc(&alloc) {}
+
+        void operator()(TObj* obj) const
+        {
+            COMMS_ASSERT(m_alloc != nullptr);
+            m_alloc->release(obj);
+        }
+
+    private:
+        ObjSlabAlloc* m_alloc = nullptr;
+    };
+
+    using Ptr = std::unique_ptr<TObj, Deleter>;
+
+    ObjSlabAlloc() = default;
+    ObjSlabAlloc(const ObjSlabAlloc&) = delete;
+    ObjSlabAlloc& operator=(const ObjSlabAlloc&) = delete;
+
+    ~ObjSlabAlloc()
+    {
+        setSlabLimit(0U);
+    }
+
+    template <typename TAllocObj, typename... TArgs>
+    Ptr alloc(TArgs&&... args)
+    {
+        static_assert(std::is_same<TAllocObj, TObj>::value, "Only the same type can be allocated");
+        void* mem = nullptr;
+        if (m_slab != nullptr) {
+            auto* chunk = m_slab;
+            m_slab = chunk->m_next;
+            --m_slabCount;
+            chunk->~FreeChunk();
+            mem = chunk;
+        }
+        else {
+            mem = AllocHooks::alloc(sizeof(TObj));
+        }
+
+        if (mem == nullptr) {
+            return Ptr(nullptr, Deleter(*this));
+        }
+
+        return Ptr(new (mem) TObj(std::forward<TArgs>(args)...), Deleter(*this));
+    }
+
+    Ptr wrap(TObj* obj)
+    {
+        return Ptr(obj, Deleter(*this));
+    }
+
+    void setSlabLimit(unsigned limit)
+    {
+        m_slabLimit = limit;
+        while (m_slabLimit < m_slabCount) {
+            auto* chunk = m_slab;
+            m_slab = chunk->m_next;
+            --m_slabCount;
+            chunk->~FreeChunk();
+            AllocHooks::free(chunk, sizeof(TObj));
+        }
+    }
+
+private:
+    struct FreeChunk
+    {
+        FreeChunk* m_next = nullptr;
+    };
+
+    static_assert(sizeof(FreeChunk) <= sizeof(TObj));
+    static_assert(alignof(TObj) <= alignof(std::max_align_t));
+
+    void release(TObj* obj)
+    {
+        obj->~TObj();
+        if (m_slabCount < m_slabLimit) {
+            auto* chunk = new (obj) FreeChunk;
+            chunk->m_next = m_slab;
+            m_slab = chunk;
+            ++m_slabCount;
+            return;
+        }
+
+        AllocHooks::free(obj, sizeof(TObj));
+    }
+
+    FreeChunk* m_slab = nullptr;
+    unsigned m_slabCount = 0U;
+    unsigned m_slabLimit = 0U;
+};
+
+} // namespace details
+
 template <typename TObj, unsigned TLimit>
 class ObjAllocator
 {
     template <typename ...>
-    using DynMemoryAlloc = comms::util::alloc::DynMemory<TObj>;
+    using DynMemoryAlloc = details::ObjSlabAlloc<TObj>;
 
     template <typename ...>
     using InPlaceAlloc = comms::util::alloc::InPlacePool<TObj, TLimit>;
@@ -49,6 +166,15 @@ public:
         static_cast<void>(ptr);
     }
 
+    // Amount of the released objects which memory is retained for reuse,
+    // relevant only for the dynamic memory allocation.
+    void setSlabLimit([[maybe_unused]] unsigned limit)
+    {
+        if constexpr (TLimit == 0U) {
+            m_alloc.setSlabLimit(limit);
+        }
+    }
+
 private:
     AllocType m_alloc;
 };
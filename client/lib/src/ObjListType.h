@@ -9,6 +9,8 @@
 
 #pragma once
 
+#include "AllocHooks.h"
+
 #include "comms/util/StaticVector.h"
 #include "comms/util/type_traits.h"
 
@@ -24,7 +26,7 @@ template <typename TObj, unsigned TLimit, bool THasFeature>
 class ObjListTypeHelper
 {
     template <typename ...>
-    using DynVector = std::vector<TObj>;
+    using DynVector = std::vector<TObj, HooksAllocator<TObj> >;
 
     template <typename ...>
     using StaticVector = comms::util::StaticVector<TObj, TLimit>;
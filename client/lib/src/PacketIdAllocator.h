@@ -0,0 +1,288 @@
+//
+// Copyright 2024 - 2026 (C). Alex Robenko. All rights reserved.
+//
+// SPDX-License-Identifier: MPL-2.0
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include "ExtConfig.h"
+#include "ObjListType.h"
+
+#include "comms/Assert.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+namespace cc_mqttsn_client
+{
+
+namespace details
+{
+
+inline unsigned packetIdLowestBitIdx(std::uint64_t value)
+{
+    COMMS_ASSERT(value != 0U);
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<unsigned>(__builtin_ctzll(value));
+#else
+    unsigned idx = 0U;
+    while ((value & 1U) == 0U) {
+        value >>= 1U;
+        ++idx;
+    }
+    return idx;
+#endif
+}
+
+} // namespace details
+
+// Allocation of the packet (message) IDs in the sequential order skipping
+// the ones that are still in use. The values 0 and 0xffff are never allocated.
+// When the amount of the allocated IDs is unlimited (TLimit == 0) the
+// allocation state is kept in the bitmap of all the possible IDs with an extra
+// summary bitmap of the fully allocated words, i.e. the search for the free ID
+// requires scanning of just a couple of words. Otherwise the allocated IDs are
+// kept in a compact slots array bounded by the (small) limit.
+template <unsigned TLimit>
+class PacketIdAllocatorImpl
+{
+public:
+    std::size_t size() const
+    {
+        return m_count;
+    }
+
+    bool empty() const
+    {
+        return m_count == 0U;
+    }
+
+    bool isAllocated(std::uint16_t id) const
+    {
+        if ((id == 0U) || (id == InvalidId)) {
+            return false;
+        }
+
+        for (auto slotId : m_slots) {
+            if (slotId == id) {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    // Returns 0 when no more IDs are available
+    std::uint16_t alloc()
+    {
+        if (m_slots.size() <= m_count) {
+            return 0U;
+        }
+
+        auto nextId = m_lastId;
+        while (true) {
+            nextId = static_cast<std::uint16_t>(nextId + 1U);
+            if ((nextId == 0U) || (nextId == InvalidId)) {
+                nextId = 1U;
+            }
+
+            std::size_t freeSlot = m_slots.size();
+            bool used = false;
+            for (auto idx = 0U; idx < m_slots.size(); ++idx) {
+                auto slotId = m_slots[idx];
+                if (slotId == nextId) {
+                    used = true;
+                    break;
+                }
+
+                if ((slotId == 0U) && (m_slots.size() <= freeSlot)) {
+                    freeSlot = idx;
+                }
+            }
+
+            if (used) {
+                continue;
+            }
+
+            COMMS_ASSERT(freeSlot < m_slots.size());
+            m_slots[freeSlot] = nextId;
+            break;
+        }
+
+        ++m_count;
+        m_lastId = nextId;
+        return nextId;
+    }
+
+    bool release(std::uint16_t id)
+    {
+        if (id == 0U) {
+            return false;
+        }
+
+        for (auto& slotId : m_slots) {
+            if (slotId == id) {
+                slotId = 0U;
+                COMMS_ASSERT(0U < m_count);
+                --m_count;
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+private:
+    static constexpr std::uint16_t InvalidId = std::numeric_limits<std::uint16_t>::max();
+
+    std::array<std::uint16_t, TLimit> m_slots = {{0U}};
+    unsigned m_count = 0U;
+    std::uint16_t m_lastId = 0U;
+};
+
+template <>
+class PacketIdAllocatorImpl<0U>
+{
+public:
+    std::size_t size() const
+    {
+        return m_count;
+    }
+
+    bool empty() const
+    {
+        return m_count == 0U;
+    }
+
+    bool isAllocated(std::uint16_t id) const
+    {
+        if ((id == 0U) || (id == InvalidId) || m_words.empty()) {
+            return false;
+        }
+
+        return (m_words[id / WordBits] & bitMask(id % WordBits)) != 0U;
+    }
+
+    // Returns 0 when no more IDs are available
+    std::uint16_t alloc()
+    {
+        if (MaxAllocated <= m_count) {
+            return 0U;
+        }
+
+        if (m_words.empty()) {
+            // The bitmap is allocated on the first use
+            m_words.resize(WordsCount, 0U);
+            setBit(0U);
+            setBit(InvalidId);
+        }
+
+        auto id = findFree(static_cast<unsigned>(m_lastId) + 1U);
+        if (id == NotFound) {
+            id = findFree(1U);
+        }
+
+        COMMS_ASSERT(id != NotFound);
+        COMMS_ASSERT((0U < id) && (id < InvalidId));
+        setBit(id);
+        ++m_count;
+        m_lastId = static_cast<std::uint16_t>(id);
+        return m_lastId;
+    }
+
+    bool release(std::uint16_t id)
+    {
+        if (!isAllocated(id)) {
+            return false;
+        }
+
+        auto wordIdx = id / WordBits;
+        m_words[wordIdx] &= ~bitMask(id % WordBits);
+        m_fullWords[wordIdx / WordBits] &= ~bitMask(wordIdx % WordBits);
+        COMMS_ASSERT(0U < m_count);
+        --m_count;
+        return true;
+    }
+
+private:
+    using Word = std::uint64_t;
+    using WordsList = ObjListType<Word, 0U>;
+
+    static constexpr std::uint16_t InvalidId = std::numeric_limits<std::uint16_t>::max();
+    static constexpr unsigned WordBits = std::numeric_limits<Word>::digits;
+    static constexpr unsigned IdsCount = static_cast<unsigned>(InvalidId) + 1U;
+    static constexpr unsigned WordsCount = IdsCount / WordBits;
+    static constexpr unsigned SummaryWordsCount = WordsCount / WordBits;
+    static constexpr unsigned MaxAllocated = IdsCount - 2U; // Excluding 0 and 0xffff
+    static constexpr unsigned NotFound = std::numeric_limits<unsigned>::max();
+    static constexpr Word AllOnes = std::numeric_limits<Word>::max();
+
+    static_assert((IdsCount % WordBits) == 0U);
+    static_assert((WordsCount % WordBits) == 0U);
+
+    static constexpr Word bitMask(unsigned bitIdx)
+    {
+        return static_cast<Word>(1U) << bitIdx;
+    }
+
+    void setBit(unsigned id)
+    {
+        auto wordIdx = id / WordBits;
+        auto& word = m_words[wordIdx];
+        word |= bitMask(id % WordBits);
+        if (word == AllOnes) {
+            m_fullWords[wordIdx / WordBits] |= bitMask(wordIdx % WordBits);
+        }
+    }
+
+    // Find first free ID starting from the provided one (inclusive)
+    unsigned findFree(unsigned fromId) const
+    {
+        if (IdsCount <= fromId) {
+            return NotFound;
+        }
+
+        auto wordIdx = fromId / WordBits;
+        auto freeBits = (~m_words[wordIdx]) & (AllOnes << (fromId % WordBits));
+        if (freeBits != 0U) {
+            return (wordIdx * WordBits) + details::packetIdLowestBitIdx(freeBits);
+        }
+
+        // Find next word that is not fully allocated
+        auto nextWordIdx = wordIdx + 1U;
+        if (WordsCount <= nextWordIdx) {
+            return NotFound;
+        }
+
+        for (auto summaryIdx = nextWordIdx / WordBits; summaryIdx < SummaryWordsCount; ++summaryIdx) {
+            auto notFullWords = ~m_fullWords[summaryIdx];
+            if (summaryIdx == (nextWordIdx / WordBits)) {
+                notFullWords &= (AllOnes << (nextWordIdx % WordBits));
+            }
+
+            if (notFullWords == 0U) {
+                continue;
+            }
+
+            auto freeWordIdx = (summaryIdx * WordBits) + details::packetIdLowestBitIdx(notFullWords);
+            return (freeWordIdx * WordBits) + details::packetIdLowestBitIdx(~m_words[freeWordIdx]);
+        }
+
+        return NotFound;
+    }
+
+    WordsList m_words;
+    std::array<Word, SummaryWordsCount> m_fullWords = {{0U}};
+    unsigned m_count = 0U;
+    std::uint16_t m_lastId = 0U;
+};
+
+using PacketIdAllocator = PacketIdAllocatorImpl<ExtConfig::PacketIdsLimit>;
+
+} // namespace cc_mqttsn_client
@@ -40,6 +40,10 @@ using ProtMessage = cc_mqttsn::Message<
 
 CC_MQTTSN_ALIASES_FOR_ALL_MESSAGES(, Msg, ProtMessage, ProtocolOptions)
 
+// Incoming messages, which may refer to the data in the input buffer
+using InRegisterMsg = cc_mqttsn::message::Register<ProtMessage, InputProtocolOptions>;
+using InPublishMsg = cc_mqttsn::message::Publish<ProtMessage, InputProtocolOptions>;
+
 using ProtInputMessages =
     std::tuple<
 #if CC_MQTTSN_CLIENT_HAS_GATEWAY_DISCOVERY
@@ -52,9 +56,9 @@ using ProtInputMessages =
         cc_mqttsn::message::Willtopicreq<ProtMessage, ProtocolOptions>,
         cc_mqttsn::message::Willmsgreq<ProtMessage, ProtocolOptions>,
 #endif // #if CC_MQTTSN_CLIENT_HAS_WILL
-        cc_mqttsn::message::Register<ProtMessage, ProtocolOptions>,
+        InRegisterMsg,
         cc_mqttsn::message::Regack<ProtMessage, ProtocolOptions>,
-        cc_mqttsn::message::Publish<ProtMessage, ProtocolOptions>,
+        InPublishMsg,
         cc_mqttsn::message::Puback<ProtMessage, ProtocolOptions>,
 #if CC_MQTTSN_CLIENT_MAX_QOS >= 2
         cc_mqttsn::message::Pubcomp<ProtMessage, ProtocolOptions>,
@@ -0,0 +1,352 @@
+//
+// Copyright 2024 - 2026 (C). Alex Robenko. All rights reserved.
+//
+// SPDX-License-Identifier: MPL-2.0
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include "Config.h"
+#include "ObjListType.h"
+#include "TopicFilterDefs.h"
+
+#include "comms/Assert.h"
+
+#include "cc_mqttsn_client/common.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+
+namespace cc_mqttsn_client
+{
+
+// Storage of the registered topics with hashed lookup both by topic and
+// by topic ID, as well as intrusive least recently used order of the elements.
+// The elements are kept in slots of the ObjListType, which is either std::vector
+// or comms::util::StaticVector, and are linked to each other by their indices.
+template <unsigned TLimit>
+class RegTopicsMap
+{
+public:
+    using Info = RegTopicInfo;
+
+    RegTopicsMap()
+    {
+        if constexpr (HasFixedBuckets) {
+            m_idBuckets.resize(m_idBuckets.max_size(), InvalidIdx);
+            m_topicBuckets.resize(m_topicBuckets.max_size(), InvalidIdx);
+        }
+    }
+
+    std::size_t size() const
+    {
+        return m_count;
+    }
+
+    std::size_t max_size() const
+    {
+        return std::min(m_nodes.max_size(), static_cast<std::size_t>(InvalidIdx));
+    }
+
+    bool empty() const
+    {
+        return m_count == 0U;
+    }
+
+    Info* findTopicId(CC_MqttsnTopicId topicId)
+    {
+        if (m_idBuckets.empty()) {
+            return nullptr;
+        }
+
+        auto idx = m_idBuckets[idBucketIdx(topicId)];
+        while (idx != InvalidIdx) {
+            auto& node = m_nodes[idx];
+            if (node.m_topicId == topicId) {
+                return &node;
+            }
+
+            idx = node.m_idNext;
+        }
+
+        return nullptr;
+    }
+
+    // Find the element by topic ID that has been inserted with the provided stamp,
+    // allows validation of the cached topic ID without the topic string hashing
+    // and comparison.
+    Info* findTopicId(CC_MqttsnTopicId topicId, unsigned stamp)
+    {
+        if (m_idBuckets.empty()) {
+            return nullptr;
+        }
+
+        auto idx = m_idBuckets[idBucketIdx(topicId)];
+        while (idx != InvalidIdx) {
+            auto& node = m_nodes[idx];
+            if ((node.m_topicId == topicId) && (node.m_stamp == stamp)) {
+                return &node;
+            }
+
+            idx = node.m_idNext;
+        }
+
+        return nullptr;
+    }
+
+    Info* findTopic(const char* topic)
+    {
+        COMMS_ASSERT(topic != nullptr);
+        if (m_topicBuckets.empty()) {
+            return nullptr;
+        }
+
+        auto idx = m_topicBuckets[topicBucketIdx(topic)];
+        while (idx != InvalidIdx) {
+            auto& node = m_nodes[idx];
+            if (node.m_topic == topic) {
+                return &node;
+            }
+
+            idx = node.m_topicNext;
+        }
+
+        return nullptr;
+    }
+
+    // Mark the element as the most recently used one
+    void touch(Info& info)
+    {
+        auto idx = nodeIdx(info);
+        if (idx == m_lruTail) {
+            return;
+        }
+
+        lruUnlink(idx);
+        lruLinkTail(idx);
+    }
+
+    unsigned stamp(Info& info) const
+    {
+        return m_nodes[nodeIdx(info)].m_stamp;
+    }
+
+    // Insert new element as the most recently used one, drop the least
+    // recently used element when the limit is reached.
+    void insert(const char* topic, CC_MqttsnTopicId topicId, std::size_t limit, unsigned stamp = 0U)
+    {
+        COMMS_ASSERT(topic != nullptr);
+        COMMS_ASSERT(0U < limit);
+        COMMS_ASSERT(limit <= max_size());
+        if (limit <= m_count) {
+            COMMS_ASSERT(m_lruHead != InvalidIdx);
+            eraseIdx(m_lruHead);
+        }
+
+        unsigned idx = m_freeHead;
+        if (idx != InvalidIdx) {
+            auto& node = m_nodes[idx];
+            m_freeHead = node.m_lruNext;
+            node.m_topic = topic;
+            node.m_topicId = topicId;
+        }
+        else {
+            COMMS_ASSERT(m_nodes.size() < m_nodes.max_size());
+            m_nodes.emplace_back(topic, topicId);
+            idx = static_cast<unsigned>(m_nodes.size() - 1U);
+        }
+
+        m_nodes[idx].m_stamp = stamp;
+        ++m_count;
+        if constexpr (!HasFixedBuckets) {
+            if (m_idBuckets.size() < m_count) {
+                rehash(std::max(MinDynBucketsCount, m_count * 2U));
+            }
+        }
+
+        hashLink(idx);
+        lruLinkTail(idx);
+    }
+
+    void erase(Info& info)
+    {
+        eraseIdx(nodeIdx(info));
+    }
+
+    // Erase all the elements with the provided topic ID
+    void eraseTopicId(CC_MqttsnTopicId topicId)
+    {
+        while (true) {
+            auto* info = findTopicId(topicId);
+            if (info == nullptr) {
+                break;
+            }
+
+            erase(*info);
+        }
+    }
+
+private:
+    static constexpr unsigned InvalidIdx = std::numeric_limits<unsigned>::max();
+    static constexpr bool HasFixedBuckets = (TLimit > 0U);
+    static constexpr unsigned MinDynBucketsCount = 16U;
+
+    struct Node : public RegTopicInfo
+    {
+        template <typename T>
+        Node(T&& topic, CC_MqttsnTopicId topicId) : RegTopicInfo(std::forward<T>(topic), topicId) {}
+
+        unsigned m_lruPrev = InvalidIdx;
+        unsigned m_lruNext = InvalidIdx; // Also used as next in the free list
+        unsigned m_idNext = InvalidIdx;
+        unsigned m_topicNext = InvalidIdx;
+        unsigned m_stamp = 0U;
+    };
+
+    using NodesList = ObjListType<Node, TLimit>;
+    using BucketsList = ObjListType<unsigned, TLimit>;
+
+    unsigned nodeIdx(Info& info) const
+    {
+        auto& node = static_cast<Node&>(info);
+        auto idx = static_cast<unsigned>(&node - m_nodes.data());
+        COMMS_ASSERT(idx < m_nodes.size());
+        return idx;
+    }
+
+    static std::size_t topicHash(const char* topic)
+    {
+        // FNV-1a
+        std::uint32_t hash = 2166136261U;
+        while (*topic != '\0') {
+            hash ^= static_cast<std::uint8_t>(*topic);
+            hash *= 16777619U;
+            ++topic;
+        }
+
+        return static_cast<std::size_t>(hash);
+    }
+
+    std::size_t idBucketIdx(CC_MqttsnTopicId topicId) const
+    {
+        COMMS_ASSERT(!m_idBuckets.empty());
+        return static_cast<std::size_t>(topicId) % m_idBuckets.size();
+    }
+
+    std::size_t topicBucketIdx(const char* topic) const
+    {
+        COMMS_ASSERT(!m_topicBuckets.empty());
+        return topicHash(topic) % m_topicBuckets.size();
+    }
+
+    void hashLink(unsigned idx)
+    {
+        auto& node = m_nodes[idx];
+        auto& idBucket = m_idBuckets[idBucketIdx(node.m_topicId)];
+        node.m_idNext = idBucket;
+        idBucket = idx;
+
+        auto& topicBucket = m_topicBuckets[topicBucketIdx(node.m_topic.c_str())];
+        node.m_topicNext = topicBucket;
+        topicBucket = idx;
+    }
+
+    void hashUnlink(unsigned idx)
+    {
+        auto& node = m_nodes[idx];
+
+        auto* idLink = &m_idBuckets[idBucketIdx(node.m_topicId)];
+        while (*idLink != idx) {
+            COMMS_ASSERT(*idLink != InvalidIdx);
+            idLink = &m_nodes[*idLink].m_idNext;
+        }
+        *idLink = node.m_idNext;
+        node.m_idNext = InvalidIdx;
+
+        auto* topicLink = &m_topicBuckets[topicBucketIdx(node.m_topic.c_str())];
+        while (*topicLink != idx) {
+            COMMS_ASSERT(*topicLink != InvalidIdx);
+            topicLink = &m_nodes[*topicLink].m_topicNext;
+        }
+        *topicLink = node.m_topicNext;
+        node.m_topicNext = InvalidIdx;
+    }
+
+    void lruLinkTail(unsigned idx)
+    {
+        auto& node = m_nodes[idx];
+        node.m_lruPrev = m_lruTail;
+        node.m_lruNext = InvalidIdx;
+        if (m_lruTail != InvalidIdx) {
+            m_nodes[m_lruTail].m_lruNext = idx;
+        }
+        else {
+            m_lruHead = idx;
+        }
+
+        m_lruTail = idx;
+    }
+
+    void lruUnlink(unsigned idx)
+    {
+        auto& node = m_nodes[idx];
+        if (node.m_lruPrev != InvalidIdx) {
+            m_nodes[node.m_lruPrev].m_lruNext = node.m_lruNext;
+        }
+        else {
+            COMMS_ASSERT(m_lruHead == idx);
+            m_lruHead = node.m_lruNext;
+        }
+
+        if (node.m_lruNext != InvalidIdx) {
+            m_nodes[node.m_lruNext].m_lruPrev = node.m_lruPrev;
+        }
+        else {
+            COMMS_ASSERT(m_lruTail == idx);
+            m_lruTail = node.m_lruPrev;
+        }
+
+        node.m_lruPrev = InvalidIdx;
+        node.m_lruNext = InvalidIdx;
+    }
+
+    void eraseIdx(unsigned idx)
+    {
+        COMMS_ASSERT(0U < m_count);
+        hashUnlink(idx);
+        lruUnlink(idx);
+        m_nodes[idx].m_lruNext = m_freeHead;
+        m_freeHead = idx;
+        --m_count;
+    }
+
+    void rehash(std::size_t bucketsCount)
+    {
+        m_idBuckets.assign(bucketsCount, InvalidIdx);
+        m_topicBuckets.assign(bucketsCount, InvalidIdx);
+        auto idx = m_lruHead;
+        while (idx != InvalidIdx) {
+            hashLink(idx);
+            idx = m_nodes[idx].m_lruNext;
+        }
+    }
+
+    NodesList m_nodes;
+    BucketsList m_idBuckets;
+    BucketsList m_topicBuckets;
+    unsigned m_lruHead = InvalidIdx; // least recently used
+    unsigned m_lruTail = InvalidIdx; // most recently used
+    unsigned m_freeHead = InvalidIdx;
+    unsigned m_count = 0U;
+};
+
+using InRegTopicsMap = RegTopicsMap<Config::InRegTopicsLimit>; // key is m_topicId
+using OutRegTopicsMap = RegTopicsMap<Config::OutRegTopicsLimit>; // key is m_topic
+
+} // namespace cc_mqttsn_client
@@ -11,6 +11,8 @@
 
 #include "ExtConfig.h"
 #include "ProtocolDefs.h"
+#include "RegTopicsMap.h"
+#include "SubFilters.h"
 #include "TopicFilterDefs.h"
 
 #include "cc_mqttsn_client/common.h"
@@ -20,7 +22,7 @@ namespace cc_mqttsn_client
 
 struct ReuseState
 {
-    SubFiltersMap m_subFilters;
+    SubFilters m_subFilters;
     InRegTopicsMap m_inRegTopics;
     OutRegTopicsMap m_outRegTopics;
     std::uint16_t m_lastRecvMsgId = 0U;
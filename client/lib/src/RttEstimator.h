@@ -0,0 +1,68 @@
+//
+// Copyright 2024 - 2026 (C). Alex Robenko. All rights reserved.
+//
+// SPDX-License-Identifier: MPL-2.0
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+
+namespace cc_mqttsn_client
+{
+
+// Estimation of the retransmission timeout based on the measured round trip
+// times, similar to the one used by TCP (RFC 6298).
+class RttEstimator
+{
+public:
+    static constexpr unsigned MinRetryPeriodMs = 200U;
+    static constexpr unsigned MaxRetryPeriodMs = 60000U;
+
+    void addSample(unsigned rttMs)
+    {
+        if (!m_hasSample) {
+            m_smoothedRtt = rttMs;
+            m_rttVar = rttMs / 2U;
+            m_hasSample = true;
+            return;
+        }
+
+        auto diff = (m_smoothedRtt < rttMs) ? (rttMs - m_smoothedRtt) : (m_smoothedRtt - rttMs);
+        m_rttVar = static_cast<unsigned>(((3ULL * m_rttVar) + diff) / 4U);
+        m_smoothedRtt = static_cast<unsigned>(((7ULL * m_smoothedRtt) + rttMs) / 8U);
+    }
+
+    bool hasSample() const
+    {
+        return m_hasSample;
+    }
+
+    unsigned smoothedRtt() const
+    {
+        return m_smoothedRtt;
+    }
+
+    unsigned retryPeriod(unsigned defaultPeriod) const
+    {
+        if (!m_hasSample) {
+            return defaultPeriod;
+        }
+
+        auto period = static_cast<std::uint64_t>(m_smoothedRtt) + std::max(4ULL * m_rttVar, 1ULL);
+        period = std::max<std::uint64_t>(period, MinRetryPeriodMs);
+        period = std::min<std::uint64_t>(period, MaxRetryPeriodMs);
+        return static_cast<unsigned>(period);
+    }
+
+private:
+    unsigned m_smoothedRtt = 0U;
+    unsigned m_rttVar = 0U;
+    bool m_hasSample = false;
+};
+
+} // namespace cc_mqttsn_client
@@ -0,0 +1,154 @@
+//
+// Copyright 2024 - 2026 (C). Alex Robenko. All rights reserved.
+//
+// SPDX-License-Identifier: MPL-2.0
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include "ExtConfig.h"
+
+#include "cc_mqttsn_client/common.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace cc_mqttsn_client
+{
+
+// Fixed capacity single-producer single-consumer ring of the received frames.
+// The producer (typically interrupt handler) copies the frame into the free slot
+// and publishes it by updating the head index, the consumer (event loop) processes
+// the frame in place and releases the slot by updating the tail index. Only
+// atomic loads and stores of the indices are used, no read-modify-write operations,
+// so the ring requires only the word sized loads and stores to be lock-free. It is
+// the case also for the MCUs without atomic read-modify-write instructions
+// (like ARMv6-M), where std::atomic<unsigned> is not reported as "always lock-free".
+// The indices run over twice the capacity to distinguish between full and empty
+// states without wasting a slot.
+template <unsigned TFrames, unsigned TFrameSize>
+class RxRingImpl
+{
+public:
+    struct Slot
+    {
+        std::array<std::uint8_t, TFrameSize> m_buf;
+        unsigned m_len = 0U;
+        CC_MqttsnDataOrigin m_origin = CC_MqttsnDataOrigin_Any;
+    };
+
+    static constexpr bool isSupported()
+    {
+        return true;
+    }
+
+    // Producer side
+    CC_MqttsnErrorCode push(const std::uint8_t* buf, unsigned bufLen, CC_MqttsnDataOrigin origin)
+    {
+        if ((TFrameSize < bufLen) || ((buf == nullptr) && (0U < bufLen))) {
+            return CC_MqttsnErrorCode_BadParam;
+        }
+
+        auto head = m_head.load(std::memory_order_relaxed);
+        auto tail = m_tail.load(std::memory_order_acquire);
+        if (countInternal(head, tail) == TFrames) {
+            return CC_MqttsnErrorCode_BufferOverflow;
+        }
+
+        auto& slot = m_slots[slotIdx(head)];
+        std::copy_n(buf, bufLen, slot.m_buf.begin());
+        slot.m_len = bufLen;
+        slot.m_origin = origin;
+        m_head.store(nextIdx(head), std::memory_order_release);
+        return CC_MqttsnErrorCode_Success;
+    }
+
+    // Consumer side
+    unsigned count() const
+    {
+        return countInternal(m_head.load(std::memory_order_acquire), m_tail.load(std::memory_order_relaxed));
+    }
+
+    const Slot& front() const
+    {
+        return m_slots[slotIdx(m_tail.load(std::memory_order_relaxed))];
+    }
+
+    void pop()
+    {
+        auto tail = m_tail.load(std::memory_order_relaxed);
+        m_tail.store(nextIdx(tail), std::memory_order_release);
+    }
+
+private:
+    static constexpr unsigned IdxLimit = TFrames * 2U;
+
+    static constexpr unsigned nextIdx(unsigned idx)
+    {
+        return (idx + 1U) < IdxLimit ? (idx + 1U) : 0U;
+    }
+
+    static constexpr unsigned slotIdx(unsigned idx)
+    {
+        return idx < TFrames ? idx : (idx - TFrames);
+    }
+
+    static constexpr unsigned countInternal(unsigned head, unsigned tail)
+    {
+        return tail <= head ? (head - tail) : (head + IdxLimit - tail);
+    }
+
+    static_assert(ATOMIC_INT_LOCK_FREE != 0, "The loads and stores of the ring indices must be lock-free to be used from the interrupt context");
+
+    std::array<Slot, TFrames> m_slots;
+    std::atomic<unsigned> m_head{0U};
+    std::atomic<unsigned> m_tail{0U};
+};
+
+template <unsigned TFrameSize>
+class RxRingImpl<0U, TFrameSize>
+{
+public:
+    struct Slot
+    {
+        std::array<std::uint8_t, 1U> m_buf = {{0U}};
+        unsigned m_len = 0U;
+        CC_MqttsnDataOrigin m_origin = CC_MqttsnDataOrigin_Any;
+    };
+
+    static constexpr bool isSupported()
+    {
+        return false;
+    }
+
+    CC_MqttsnErrorCode push([[maybe_unused]] const std::uint8_t* buf, [[maybe_unused]] unsigned bufLen, [[maybe_unused]] CC_MqttsnDataOrigin origin)
+    {
+        return CC_MqttsnErrorCode_NotSupported;
+    }
+
+    unsigned count() const
+    {
+        return 0U;
+    }
+
+    const Slot& front() const
+    {
+        return m_slot;
+    }
+
+    void pop()
+    {
+    }
+
+private:
+    Slot m_slot;
+};
+
+using RxRing = RxRingImpl<ExtConfig::RxRingFrames, ExtConfig::RxRingSlotSize>;
+
+} // namespace cc_mqttsn_client
@@ -0,0 +1,309 @@
+//
+// Copyright 2024 - 2026 (C). Alex Robenko. All rights reserved.
+//
+// SPDX-License-Identifier: MPL-2.0
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "SubFilters.h"
+
+#include "comms/Assert.h"
+
+#include <algorithm>
+
+namespace cc_mqttsn_client
+{
+
+namespace
+{
+
+static constexpr char LevelSep = '/';
+static constexpr std::string_view MultLevelWildcardStr("#");
+static constexpr std::string_view SingleLevelWildcardStr("+");
+
+bool isLessFilter(const RegTopicInfo& info, const char* filter, CC_MqttsnTopicId topicId)
+{
+    if (info.m_topic != filter) {
+        return info.m_topic < filter;
+    }
+
+    return info.m_topicId < topicId;
+}
+
+template <typename TMap>
+auto findFilter(TMap& map, const char* filter, CC_MqttsnTopicId topicId)
+{
+    auto iter =
+        std::lower_bound(
+            map.begin(), map.end(), filter,
+            [topicId](auto& info, const char* filterParam)
+            {
+                return isLessFilter(info, filterParam, topicId);
+            });
+
+    if ((iter != map.end()) &&
+        (iter->m_topicId == topicId) &&
+        (iter->m_topic == filter)) {
+        return iter;
+    }
+
+    return map.end();
+}
+
+} // namespace
+
+namespace details
+{
+
+void SubFiltersTree::add(std::string_view filter)
+{
+    auto* node = &m_root;
+    while (true) {
+        auto sepPos = filter.find(LevelSep);
+        auto level = filter.substr(0, sepPos);
+        auto iter = node->m_children.find(level);
+        if (iter == node->m_children.end()) {
+            iter = node->m_children.emplace(std::string(level), std::make_unique<Node>()).first;
+        }
+
+        COMMS_ASSERT(iter->second);
+        node = iter->second.get();
+        if (sepPos == std::string_view::npos) {
+            break;
+        }
+
+        filter = filter.substr(sepPos + 1U);
+    }
+
+    node->m_terminal = true;
+}
+
+void SubFiltersTree::remove(std::string_view filter)
+{
+    removeInternal(m_root, filter);
+}
+
+bool SubFiltersTree::isMatch(std::string_view topic) const
+{
+    return isMatchInternal(m_root, topic, false);
+}
+
+bool SubFiltersTree::empty() const
+{
+    return m_root.m_children.empty();
+}
+
+bool SubFiltersTree::isMatchInternal(const Node& node, std::string_view topic, bool lastLevelProcessed)
+{
+    // The '#' also matches the parent level
+    auto multIter = node.m_children.find(MultLevelWildcardStr);
+    if ((multIter != node.m_children.end()) && (multIter->second->m_terminal)) {
+        return true;
+    }
+
+    if (lastLevelProcessed) {
+        return node.m_terminal;
+    }
+
+    auto sepPos = topic.find(LevelSep);
+    auto level = topic.substr(0, sepPos);
+    auto lastLevel = (sepPos == std::string_view::npos);
+    auto remTopic = lastLevel ? std::string_view() : topic.substr(sepPos + 1U);
+
+    auto iter = node.m_children.find(level);
+    if (lastLevel && level.empty()) {
+        // The empty trailing level is matched only by the exact empty level (or '#' checked above),
+        // same as the isTopicMatch() does.
+        return (iter != node.m_children.end()) && (iter->second->m_terminal);
+    }
+
+    if ((iter != node.m_children.end()) && isMatchInternal(*iter->second, remTopic, lastLevel)) {
+        return true;
+    }
+
+    auto singleIter = node.m_children.find(SingleLevelWildcardStr);
+    return
+        (singleIter != node.m_children.end()) &&
+        (isMatchInternal(*singleIter->second, remTopic, lastLevel));
+}
+
+bool SubFiltersTree::removeInternal(Node& node, std::string_view filter)
+{
+    // Returns true when the node can be removed from its parent
+    auto sepPos = filter.find(LevelSep);
+    auto level = filter.substr(0, sepPos);
+    auto iter = node.m_children.find(level);
+    if (iter == node.m_children.end()) {
+        return false;
+    }
+
+    auto& child = *iter->second;
+    if (sepPos == std::string_view::npos) {
+        child.m_terminal = false;
+    }
+    else if (!removeInternal(child, filter.substr(sepPos + 1U))) {
+        return false;
+    }
+
+    if ((!child.m_terminal) && (child.m_children.empty())) {
+        node.m_children.erase(iter);
+    }
+
+    return (!node.m_terminal) && (node.m_children.empty());
+}
+
+} // namespace details
+
+bool SubFilters::hasTopic(const char* filter) const
+{
+    COMMS_ASSERT(filter != nullptr);
+    return findFilter(m_filters, filter, 0U) != m_filters.end();
+}
+
+bool SubFilters::hasTopicId(CC_MqttsnTopicId topicId) const
+{
+    return findFilter(m_filters, "", topicId) != m_filters.end();
+}
+
+void SubFilters::addTopic(const char* filter)
+{
+    COMMS_ASSERT(filter != nullptr);
+    auto iter =
+        std::lower_bound(
+            m_filters.begin(), m_filters.end(), filter,
+            [](auto& info, const char* filterParam)
+            {
+                return isLessFilter(info, filterParam, 0U);
+            });
+
+    if ((iter != m_filters.end()) && (iter->m_topic == filter)) {
+        return;
+    }
+
+    if (m_filters.max_size() <= m_filters.size()) {
+        return;
+    }
+
+    m_filters.emplace(iter, filter);
+
+    if constexpr (HasTree) {
+        m_tree.add(filter);
+    }
+}
+
+void SubFilters::addTopicId(CC_MqttsnTopicId topicId)
+{
+    auto iter =
+        std::lower_bound(
+            m_filters.begin(), m_filters.end(), topicId,
+            [](auto& info, CC_MqttsnTopicId topicIdParam)
+            {
+                return isLessFilter(info, "", topicIdParam);
+            });
+
+    if ((iter != m_filters.end()) && (iter->m_topic.empty()) && (iter->m_topicId == topicId)) {
+        return;
+    }
+
+    if (m_filters.max_size() <= m_filters.size()) {
+        return;
+    }
+
+    m_filters.emplace(iter, topicId);
+}
+
+void SubFilters::removeTopic(const char* filter)
+{
+    COMMS_ASSERT(filter != nullptr);
+    auto iter = findFilter(m_filters, filter, 0U);
+    if (iter == m_filters.end()) {
+        return;
+    }
+
+    m_filters.erase(iter);
+
+    if constexpr (HasTree) {
+        m_tree.remove(filter);
+    }
+}
+
+void SubFilters::removeTopicId(CC_MqttsnTopicId topicId)
+{
+    auto iter = findFilter(m_filters, "", topicId);
+    if (iter != m_filters.end()) {
+        m_filters.erase(iter);
+    }
+}
+
+bool SubFilters::isMatch(std::string_view topic) const
+{
+    if constexpr (HasTree) {
+        return m_tree.isMatch(topic);
+    }
+    else {
+        return
+            std::any_of(
+                m_filters.begin(), m_filters.end(),
+                [topic](auto& info)
+                {
+                    return
+                        (!info.m_topic.empty()) &&
+                        isTopicMatch(std::string_view(info.m_topic.c_str(), info.m_topic.size()), topic);
+                });
+    }
+}
+
+bool SubFilters::isTopicMatch(std::string_view filter, std::string_view topic)
+{
+    if ((filter.size() == 1U) && (filter[0] == '#')) {
+        return true;
+    }
+
+    if (topic.empty()) {
+        return filter.empty();
+    }
+
+    auto filterSepPos = filter.find_first_of("/");
+    auto topicSepPos = topic.find_first_of("/");
+
+    if ((filterSepPos == std::string_view::npos) &&
+        (topicSepPos != std::string_view::npos)) {
+        return false;
+    }
+
+    if (topicSepPos != std::string_view::npos) {
+        COMMS_ASSERT(filterSepPos != std::string_view::npos);
+        if (((filter[0] == '+') && (filterSepPos == 1U)) ||
+            (filter.substr(0, filterSepPos) == topic.substr(0, topicSepPos))) {
+            return isTopicMatch(filter.substr(filterSepPos + 1U), topic.substr(topicSepPos + 1U));
+        }
+
+        return false;
+    }
+
+    if (filterSepPos != std::string_view::npos) {
+        COMMS_ASSERT(topicSepPos == std::string_view::npos);
+        if (filter.size() <= (filterSepPos + 1U)) {
+            // trailing '/' on the filter without any character after that
+            return false;
+        }
+
+        if (((filter[0] == '+') && (filterSepPos == 1U)) ||
+            (filter.substr(0, filterSepPos) == topic)) {
+            return isTopicMatch(filter.substr(filterSepPos + 1U), std::string_view());
+        }
+
+        return false;
+    }
+
+    COMMS_ASSERT(filterSepPos == std::string_view::npos);
+    COMMS_ASSERT(topicSepPos == std::string_view::npos);
+
+    return
+        (((filter[0] == '+') && (filter.size() == 1U)) ||
+         (filter == topic));
+}
+
+} // namespace cc_mqttsn_client
@@ -0,0 +1,102 @@
+//
+// Copyright 2024 - 2026 (C). Alex Robenko. All rights reserved.
+//
+// SPDX-License-Identifier: MPL-2.0
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include "ExtConfig.h"
+#include "TopicFilterDefs.h"
+
+#include "comms/util/type_traits.h"
+
+#include "cc_mqttsn_client/common.h"
+
+#include <map>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace cc_mqttsn_client
+{
+
+namespace details
+{
+
+// Topic level tree of the subscribed filters, used when dynamic memory allocation is available.
+class SubFiltersTree
+{
+public:
+    void add(std::string_view filter);
+    void remove(std::string_view filter);
+    bool isMatch(std::string_view topic) const;
+    bool empty() const;
+
+private:
+    struct Node
+    {
+        using Ptr = std::unique_ptr<Node>;
+        using ChildrenMap = std::map<std::string, Ptr, std::less<>>;
+
+        ChildrenMap m_children;
+        bool m_terminal = false;
+    };
+
+    static bool isMatchInternal(const Node& node, std::string_view topic, bool lastLevelProcessed);
+    static bool removeInternal(Node& node, std::string_view filter);
+
+    Node m_root;
+};
+
+struct NoSubFiltersTree
+{
+    void add([[maybe_unused]] std::string_view filter) {}
+    void remove([[maybe_unused]] std::string_view filter) {}
+    bool isMatch([[maybe_unused]] std::string_view topic) const
+    {
+        return false;
+    }
+};
+
+} // namespace details
+
+class SubFilters
+{
+public:
+    static constexpr bool HasTree = ExtConfig::HasDynMemAlloc && ExtConfig::HasSubTopicVerification;
+
+    bool hasTopic(const char* filter) const;
+    bool hasTopicId(CC_MqttsnTopicId topicId) const;
+    void addTopic(const char* filter);
+    void addTopicId(CC_MqttsnTopicId topicId);
+    void removeTopic(const char* filter);
+    void removeTopicId(CC_MqttsnTopicId topicId);
+    bool isMatch(std::string_view topic) const;
+
+    static bool isTopicMatch(std::string_view filter, std::string_view topic);
+
+private:
+    template <typename...>
+    using Tree = details::SubFiltersTree;
+
+    template <typename...>
+    using NoTree = details::NoSubFiltersTree;
+
+    using TreeType =
+        typename comms::util::LazyShallowConditional<
+            HasTree
+        >::template Type<
+            Tree,
+            NoTree
+        >;
+
+    // Sorted by topic, then by topic ID, pre-defined topic IDs (with empty topic) are at the front
+    SubFiltersMap m_filters;
+    TreeType m_tree;
+};
+
+} // namespace cc_mqttsn_client
@@ -12,8 +12,9 @@
 #include "comms/Assert.h"
 
 #include <algorithm>
-#include <iterator>
+#include <functional>
 #include <limits>
+#include <utility>
 
 namespace cc_mqttsn_client
 {
@@ -23,28 +24,22 @@ TimerMgr::Timer TimerMgr::allocTimer()
     auto createTimer =
         [this](unsigned idx)
         {
-            m_timers[idx].m_allocated = true;
+            auto& info = m_timers[idx];
+            COMMS_ASSERT(!info.m_allocated);
+            info.m_allocated = true;
             ++m_allocatedTimers;
             return Timer(*this, idx);
         };
 
-    if (m_allocatedTimers < m_timers.size()) {
-        auto iter = std::find_if(
-            m_timers.begin(), m_timers.end(),
-            [](auto& info)
-            {
-                return !info.m_allocated;
-            });
-
-        if (iter != m_timers.end()) {
-            auto idx = static_cast<unsigned>(std::distance(m_timers.begin(), iter));
-            return createTimer(idx);
-        }
-
-        [[maybe_unused]] static constexpr bool Should_not_happen = false;
-        COMMS_ASSERT(Should_not_happen);
+    if (!m_freeIdxs.empty()) {
+        // Reuse the lowest free slot, the same one the linear search used to find
+        std::pop_heap(m_freeIdxs.begin(), m_freeIdxs.end(), std::greater<unsigned>());
+        auto idx = m_freeIdxs.back();
+        m_freeIdxs.pop_back();
+        return createTimer(idx);
     }
 
+    COMMS_ASSERT(m_allocatedTimers == m_timers.size());
     if (m_timers.max_size() <= m_timers.size()) {
         return Timer(*this);
     }
@@ -60,29 +55,40 @@ void TimerMgr::tick(unsigned ms)
     {
         TimeoutCb m_timeoutCb = nullptr;
         void* m_timeoutData = nullptr;
+        unsigned m_idx = 0U;
     };
 
     using CbList = ObjListType<CbInfo, ExtConfig::TimersLimit>;
     CbList cbList;
 
-    for (auto idx = 0U; idx < m_timers.size(); ++idx) {
+    m_now += ms;
+    while (!m_heap.empty()) {
+        auto idx = m_heap.front();
         auto& info = m_timers[idx];
-        if ((!info.m_allocated) ||
-            (info.m_timeoutCb == nullptr) ||
-            (info.m_suspended)) {
-            continue;
+        COMMS_ASSERT(info.m_allocated);
+        COMMS_ASSERT(info.m_timeoutCb != nullptr);
+        COMMS_ASSERT(!info.m_suspended);
+        if (m_now < info.m_timeoutMs) {
+            break;
         }
 
-        if (info.m_timeoutMs <= ms) {
-            cbList.push_back({info.m_timeoutCb, info.m_timeoutData});
-            timerCancel(idx);
-            COMMS_ASSERT(!timerIsActive(idx));
-            continue;
-        }
+        cbList.push_back({info.m_timeoutCb, info.m_timeoutData, idx});
+        timerCancel(idx);
+        COMMS_ASSERT(!timerIsActive(idx));
+    }
 
-        info.m_timeoutMs -= ms;
+    if (cbList.empty()) {
+        return;
     }
 
+    // Keep the invocation order of the simultaneously expired timers independent of the heap layout
+    std::sort(
+        cbList.begin(), cbList.end(),
+        [](auto& first, auto& second)
+        {
+            return first.m_idx < second.m_idx;
+        });
+
     for (auto& info : cbList) {
         info.m_timeoutCb(info.m_timeoutData);
     }
@@ -90,40 +96,19 @@ void TimerMgr::tick(unsigned ms)
 
 unsigned TimerMgr::getMinWait() const
 {
-    if (m_allocatedTimers == 0U) {
-        return 0U;
-    }
-
-    static constexpr auto Limit = std::numeric_limits<std::uint64_t>::max();
-    auto result = Limit;
-
-    for (auto& info : m_timers) {
-        if ((!info.m_allocated) ||
-            (info.m_timeoutCb == nullptr) ||
-            (info.m_suspended)) {
-            continue;
-        }
-
-        result = std::min(result, info.m_timeoutMs);
-    }
-
-    if (result == Limit) {
+    if (m_heap.empty()) {
         return 0U;
     }
 
+    auto& info = m_timers[m_heap.front()];
+    COMMS_ASSERT(m_now <= info.m_timeoutMs);
+    auto result = info.m_timeoutMs - m_now;
     return static_cast<unsigned>(std::min(result, std::uint64_t(std::numeric_limits<unsigned>::max())));
 }
 
 unsigned TimerMgr::allocCount() const
 {
-    return
-        static_cast<unsigned>(
-            std::count_if(
-                m_timers.begin(), m_timers.end(),
-                [](auto& info)
-                {
-                    return info.m_allocated;
-                }));
+    return m_allocatedTimers;
 }
 
 void TimerMgr::freeTimer(unsigned idx)
@@ -136,8 +121,11 @@ void TimerMgr::freeTimer(unsigned idx)
     COMMS_ASSERT(m_allocatedTimers > 0U);
     auto& info = m_timers[idx];
     COMMS_ASSERT(info.m_allocated);
+    heapRemove(idx);
     info = TimerInfo();
     --m_allocatedTimers;
+    m_freeIdxs.push_back(idx);
+    std::push_heap(m_freeIdxs.begin(), m_freeIdxs.end(), std::greater<unsigned>());
 }
 
 void TimerMgr::timerWait(unsigned idx, std::uint64_t timeoutMs, TimeoutCb cb, void* data)
@@ -150,9 +138,16 @@ void TimerMgr::timerWait(unsigned idx, std::uint64_t timeoutMs, TimeoutCb cb, vo
     auto& info = m_timers[idx];
     COMMS_ASSERT(info.m_allocated);
     COMMS_ASSERT(cb != nullptr);
-    info.m_timeoutMs = timeoutMs;
+    heapRemove(idx);
     info.m_timeoutCb = cb;
     info.m_timeoutData = data;
+    if (info.m_suspended) {
+        info.m_timeoutMs = timeoutMs;
+        return;
+    }
+
+    info.m_timeoutMs = m_now + timeoutMs;
+    heapInsert(idx);
 }
 
 void TimerMgr::timerCancel(unsigned idx)
@@ -164,6 +159,7 @@ void TimerMgr::timerCancel(unsigned idx)
 
     auto& info = m_timers[idx];
     COMMS_ASSERT(info.m_allocated);
+    heapRemove(idx);
     info.m_timeoutMs = 0;
     info.m_timeoutCb = nullptr;
     info.m_timeoutData = nullptr;
@@ -191,7 +187,25 @@ void TimerMgr::timerSetSuspended(unsigned idx, bool suspended)
 
     auto& info = m_timers[idx];
     COMMS_ASSERT(info.m_allocated);
+    if (info.m_suspended == suspended) {
+        return;
+    }
+
     info.m_suspended = suspended;
+    if (info.m_timeoutCb == nullptr) {
+        return;
+    }
+
+    if (suspended) {
+        // Preserve the remaining time, suspended timers don't count down
+        heapRemove(idx);
+        COMMS_ASSERT(m_now <= info.m_timeoutMs);
+        info.m_timeoutMs -= m_now;
+        return;
+    }
+
+    info.m_timeoutMs += m_now;
+    heapInsert(idx);
 }
 
 bool TimerMgr::timerIsSuspended(unsigned idx) const
@@ -206,4 +220,89 @@ bool TimerMgr::timerIsSuspended(unsigned idx) const
     return info.m_suspended;
 }
 
+bool TimerMgr::heapLess(unsigned heapIdx1, unsigned heapIdx2) const
+{
+    auto& info1 = m_timers[m_heap[heapIdx1]];
+    auto& info2 = m_timers[m_heap[heapIdx2]];
+    return info1.m_timeoutMs < info2.m_timeoutMs;
+}
+
+void TimerMgr::heapSwap(unsigned heapIdx1, unsigned heapIdx2)
+{
+    std::swap(m_heap[heapIdx1], m_heap[heapIdx2]);
+    m_timers[m_heap[heapIdx1]].m_heapIdx = heapIdx1;
+    m_timers[m_heap[heapIdx2]].m_heapIdx = heapIdx2;
+}
+
+void TimerMgr::heapSiftUp(unsigned heapIdx)
+{
+    while (0U < heapIdx) {
+        auto parentIdx = (heapIdx - 1U) / 2U;
+        if (!heapLess(heapIdx, parentIdx)) {
+            break;
+        }
+
+        heapSwap(heapIdx, parentIdx);
+        heapIdx = parentIdx;
+    }
+}
+
+void TimerMgr::heapSiftDown(unsigned heapIdx)
+{
+    auto heapSize = static_cast<unsigned>(m_heap.size());
+    while (true) {
+        auto minIdx = heapIdx;
+        auto leftIdx = (heapIdx * 2U) + 1U;
+        auto rightIdx = leftIdx + 1U;
+
+        if ((leftIdx < heapSize) && heapLess(leftIdx, minIdx)) {
+            minIdx = leftIdx;
+        }
+
+        if ((rightIdx < heapSize) && heapLess(rightIdx, minIdx)) {
+            minIdx = rightIdx;
+        }
+
+        if (minIdx == heapIdx) {
+            break;
+        }
+
+        heapSwap(heapIdx, minIdx);
+        heapIdx = minIdx;
+    }
+}
+
+void TimerMgr::heapInsert(unsigned idx)
+{
+    auto& info = m_timers[idx];
+    COMMS_ASSERT(info.m_heapIdx == InvalidIdx);
+    COMMS_ASSERT(m_heap.size() < m_heap.max_size());
+    info.m_heapIdx = static_cast<unsigned>(m_heap.size());
+    m_heap.push_back(idx);
+    heapSiftUp(info.m_heapIdx);
+}
+
+void TimerMgr::heapRemove(unsigned idx)
+{
+    auto heapIdx = m_timers[idx].m_heapIdx;
+    if (heapIdx == InvalidIdx) {
+        return;
+    }
+
+    COMMS_ASSERT(heapIdx < m_heap.size());
+    COMMS_ASSERT(m_heap[heapIdx] == idx);
+    auto lastIdx = static_cast<unsigned>(m_heap.size() - 1U);
+    if (heapIdx != lastIdx) {
+        heapSwap(heapIdx, lastIdx);
+    }
+
+    m_heap.pop_back();
+    m_timers[idx].m_heapIdx = InvalidIdx;
+
+    if (heapIdx < m_heap.size()) {
+        heapSiftDown(heapIdx);
+        heapSiftUp(heapIdx);
+    }
+}
+
 } // namespace cc_mqttsn_client
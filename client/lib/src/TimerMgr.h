@@ -15,6 +15,7 @@
 #include "comms/util/StaticVector.h"
 #include "comms/util/type_traits.h"
 
+#include <cstdint>
 #include <limits>
 
 namespace cc_mqttsn_client
@@ -99,16 +100,21 @@ public:
     unsigned allocCount() const;
 
 private:
+    static const unsigned InvalidIdx = std::numeric_limits<unsigned>::max();
+
     struct TimerInfo
     {
+        // Absolute deadline while in the heap, remaining time while suspended
         std::uint64_t m_timeoutMs = 0U;
         TimeoutCb m_timeoutCb = nullptr;
         void* m_timeoutData = nullptr;
+        unsigned m_heapIdx = InvalidIdx;
         bool m_allocated = false;
         bool m_suspended = false;
     };
 
     using StorageType = ObjListType<TimerInfo, ExtConfig::TimersLimit>;
+    using IdxListType = ObjListType<unsigned, ExtConfig::TimersLimit>;
 
     friend class Timer;
 
@@ -119,7 +125,17 @@ private:
     void timerSetSuspended(unsigned idx, bool suspended);
     bool timerIsSuspended(unsigned idx) const;
 
+    bool heapLess(unsigned heapIdx1, unsigned heapIdx2) const;
+    void heapSwap(unsigned heapIdx1, unsigned heapIdx2);
+    void heapSiftUp(unsigned heapIdx);
+    void heapSiftDown(unsigned heapIdx);
+    void heapInsert(unsigned idx);
+    void heapRemove(unsigned idx);
+
     StorageType m_timers;
+    IdxListType m_heap;
+    IdxListType m_freeIdxs;
+    std::uint64_t m_now = 0U;
     unsigned m_allocatedTimers = 0U;
 };
 
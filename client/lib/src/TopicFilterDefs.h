@@ -34,29 +34,6 @@ struct RegTopicInfo
     RegTopicInfo(CC_MqttsnTopicId topicId) noexcept : m_topicId(topicId) {}
 };
 
-struct TimestampStorage
-{
-    using Timestamp = std::uint64_t;
-    Timestamp m_timestamp = 0U;
-
-    TimestampStorage(Timestamp timestamp) : m_timestamp(timestamp) {}
-};
-
-struct FullRegTopicInfo : public TimestampStorage, public RegTopicInfo
-{
-    template <typename T>
-    FullRegTopicInfo(Timestamp timestamp, T&& topic, CC_MqttsnTopicId topicId) :
-        TimestampStorage(timestamp),
-        RegTopicInfo(std::forward<T>(topic), topicId)
-    {
-    }
-
-    FullRegTopicInfo(Timestamp timestamp, const char* topic) : TimestampStorage(timestamp), RegTopicInfo(topic) {}
-    FullRegTopicInfo(Timestamp timestamp, CC_MqttsnTopicId topicId) : TimestampStorage(timestamp), RegTopicInfo(topicId) {}
-};
-
 using SubFiltersMap = ObjListType<RegTopicInfo, Config::SubFiltersLimit, Config::HasSubTopicVerification>; // key is m_topic
-using InRegTopicsMap = ObjListType<FullRegTopicInfo, Config::InRegTopicsLimit>; // key is m_topicId;
-using OutRegTopicsMap = ObjListType<FullRegTopicInfo, Config::OutRegTopicsLimit>; // key is m_topic;
 
 } // namespace cc_mqttsn_client
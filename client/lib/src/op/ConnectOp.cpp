@@ -34,7 +34,7 @@ inline ConnectOp* asConnectOp(void* data)
 } // namespace
 
 ConnectOp::ConnectOp(ClientImpl& client) :
-    Base(client),
+    Base(client, Type_Connect),
     m_timer(client.timerMgr().allocTimer())
 {
 }
@@ -263,11 +263,6 @@ void ConnectOp::handle(ConnackMsg& msg)
     completeOpInternal(CC_MqttsnAsyncOpStatus_Complete, &info);
 }
 
-Op::Type ConnectOp::typeImpl() const
-{
-    return Type_Connect;
-}
-
 void ConnectOp::terminateOpImpl(CC_MqttsnAsyncOpStatus status)
 {
     completeOpInternal(status);
@@ -285,7 +280,7 @@ void ConnectOp::completeOpInternal(CC_MqttsnAsyncOpStatus status, const CC_Mqtts
 
 void ConnectOp::restartTimer()
 {
-    m_timer.wait(getRetryPeriod(), &ConnectOp::opTimeoutCb, this);
+    m_timer.wait(getRetryWaitPeriod(), &ConnectOp::opTimeoutCb, this);
 }
 
 CC_MqttsnErrorCode ConnectOp::sendInternal()
@@ -318,6 +313,7 @@ CC_MqttsnErrorCode ConnectOp::sendInternal()
 void ConnectOp::timeoutInternal()
 {
     if (getRetryCount() == 0U) {
+        client().stats().opTimeout(type());
         errorLog("All retries of the connect operation have been exhausted.");
         completeOpInternal(CC_MqttsnAsyncOpStatus_Timeout);
         return;
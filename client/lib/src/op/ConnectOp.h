@@ -34,16 +34,15 @@ public:
 
     using Base::handle;
 #if CC_MQTTSN_CLIENT_HAS_WILL
-    void handle(WilltopicreqMsg& msg) override;
-    void handle(WillmsgreqMsg& msg) override;
+    void handle(WilltopicreqMsg& msg);
+    void handle(WillmsgreqMsg& msg);
 #endif
-    void handle(ConnackMsg& msg) override;
-
-protected:
-    virtual Type typeImpl() const override;
-    virtual void terminateOpImpl(CC_MqttsnAsyncOpStatus status) override;
+    void handle(ConnackMsg& msg);
 
 private:
+    friend class Op;
+    void terminateOpImpl(CC_MqttsnAsyncOpStatus status);
+
     enum Stage : unsigned
     {
         Stage_connect,
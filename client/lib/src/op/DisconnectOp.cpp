@@ -33,7 +33,7 @@ inline DisconnectOp* asDisconnectOp(void* data)
 } // namespace
 
 DisconnectOp::DisconnectOp(ClientImpl& client) :
-    Base(client),
+    Base(client, Type_Disconnect),
     m_timer(client.timerMgr().allocTimer())
 {
 }
@@ -132,11 +132,6 @@ void DisconnectOp::handle([[maybe_unused]] DisconnectMsg& msg)
     completeOpInternal(CC_MqttsnAsyncOpStatus_Complete);
 }
 
-Op::Type DisconnectOp::typeImpl() const
-{
-    return Type_Disconnect;
-}
-
 void DisconnectOp::terminateOpImpl(CC_MqttsnAsyncOpStatus status)
 {
     completeOpInternal(status);
@@ -154,7 +149,7 @@ void DisconnectOp::completeOpInternal(CC_MqttsnAsyncOpStatus status)
 
 void DisconnectOp::restartTimer()
 {
-    m_timer.wait(getRetryPeriod(), &DisconnectOp::opTimeoutCb, this);
+    m_timer.wait(getRetryWaitPeriod(), &DisconnectOp::opTimeoutCb, this);
 }
 
 CC_MqttsnErrorCode DisconnectOp::sendInternal()
@@ -170,6 +165,7 @@ CC_MqttsnErrorCode DisconnectOp::sendInternal()
 void DisconnectOp::timeoutInternal()
 {
     if (getRetryCount() == 0U) {
+        client().stats().opTimeout(type());
         errorLog("All retries of the disconnect or sleep operation have been exhausted.");
         completeOpInternal(CC_MqttsnAsyncOpStatus_Timeout);
         return;
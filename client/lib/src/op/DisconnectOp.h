@@ -32,18 +32,17 @@ public:
     CC_MqttsnErrorCode cancel();
 
     using Base::handle;
-    void handle(DisconnectMsg& msg) override;
+    void handle(DisconnectMsg& msg);
 
     bool isSleepConfigured() const
     {
         return m_disconnectMsg.field_duration().doesExist();
     }
 
-protected:
-    virtual Type typeImpl() const override;
-    virtual void terminateOpImpl(CC_MqttsnAsyncOpStatus status) override;
-
 private:
+    friend class Op;
+    void terminateOpImpl(CC_MqttsnAsyncOpStatus status);
+
 
     void completeOpInternal(CC_MqttsnAsyncOpStatus status);
     void restartTimer();
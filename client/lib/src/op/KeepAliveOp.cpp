@@ -27,7 +27,7 @@ inline KeepAliveOp* asKeepAliveOp(void* data)
 } // namespace
 
 KeepAliveOp::KeepAliveOp(ClientImpl& client) :
-    Base(client),
+    Base(client, Type_KeepAlive),
     m_pingTimer(client.timerMgr().allocTimer()),
     m_recvTimer(client.timerMgr().allocTimer()),
     m_respTimer(client.timerMgr().allocTimer())
@@ -64,6 +64,7 @@ void KeepAliveOp::handle([[maybe_unused]] PingrespMsg& msg)
 {
     m_respTimer.cancel();
     COMMS_ASSERT(!m_respTimer.isActive());
+    rttMeasureComplete();
     setRetryCount(client().configState().m_retryCount);
     restartRecvTimer();
 }
@@ -80,11 +81,6 @@ void KeepAliveOp::handle([[maybe_unused]] ProtMessage& msg)
     restartRecvTimer();
 }
 
-Op::Type KeepAliveOp::typeImpl() const
-{
-    return Type_KeepAlive;
-}
-
 void KeepAliveOp::restartPingTimer()
 {
     auto& state = client().sessionState();
@@ -107,8 +103,8 @@ void KeepAliveOp::restartRecvTimer()
 
 void KeepAliveOp::restartRespTimer()
 {
-    auto& state = client().configState();
-    m_respTimer.wait(state.m_retryPeriod, &KeepAliveOp::pingTimeoutCb, this);
+    setRetryPeriod(client().currentRetryPeriod());
+    m_respTimer.wait(getRetryWaitPeriod(), &KeepAliveOp::pingTimeoutCb, this);
 }
 
 void KeepAliveOp::sendPing()
@@ -127,6 +123,11 @@ void KeepAliveOp::sendPing()
 
     cl.sendMessage(msg);
     restartRespTimer();
+
+    if (st.m_connectionStatus == CC_MqttsnConnectionStatus_Connected) {
+        // In ASLEEP mode the PINGRESP is delayed by the buffered messages
+        rttMeasureStart();
+    }
 }
 
 void KeepAliveOp::pingTimeoutInternal()
@@ -134,12 +135,13 @@ void KeepAliveOp::pingTimeoutInternal()
     COMMS_ASSERT(!m_respTimer.isActive());
     auto remRetries = getRetryCount();
     if (remRetries == 0U) {
+        client().stats().opTimeout(type());
         errorLog("The gateway did not respond to PING(s)");
         client().gatewayDisconnected(CC_MqttsnGatewayDisconnectReason_NoGatewayResponse);
         return;
     }
 
-    setRetryCount(remRetries - 1U);
+    decRetryCount();
     sendPing();
 }
 
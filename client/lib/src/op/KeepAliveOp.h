@@ -31,12 +31,9 @@ public:
     void messageSent();
 
     using Base::handle;
-    virtual void handle(PingreqMsg& msg) override;
-    virtual void handle(PingrespMsg& msg) override;
-    virtual void handle(ProtMessage& msg) override;
-
-protected:
-    virtual Type typeImpl() const override;
+    void handle(PingreqMsg& msg);
+    void handle(PingrespMsg& msg);
+    void handle(ProtMessage& msg);
 
 private:
     void restartPingTimer();
@@ -12,6 +12,15 @@
 #include "ClientImpl.h"
 #include "TopicFilterDefs.h"
 
+#include "op/ConnectOp.h"
+#include "op/DisconnectOp.h"
+#include "op/KeepAliveOp.h"
+#include "op/SearchOp.h"
+#include "op/SendOp.h"
+#include "op/SubscribeOp.h"
+#include "op/UnsubscribeOp.h"
+#include "op/WillOp.h"
+
 #include "comms/util/ScopeGuard.h"
 #include "comms/cast.h"
 
@@ -32,6 +41,16 @@ static constexpr char TopicSep = '/';
 static constexpr char MultLevelWildcard = '#';
 static constexpr char SingleLevelWildcard = '+';
 
+static_assert(static_cast<unsigned>(Op::Type_Search) == CC_MqttsnOpType_Search);
+static_assert(static_cast<unsigned>(Op::Type_Connect) == CC_MqttsnOpType_Connect);
+static_assert(static_cast<unsigned>(Op::Type_KeepAlive) == CC_MqttsnOpType_KeepAlive);
+static_assert(static_cast<unsigned>(Op::Type_Disconnect) == CC_MqttsnOpType_Disconnect);
+static_assert(static_cast<unsigned>(Op::Type_Subscribe) == CC_MqttsnOpType_Subscribe);
+static_assert(static_cast<unsigned>(Op::Type_Unsubscribe) == CC_MqttsnOpType_Unsubscribe);
+static_assert(static_cast<unsigned>(Op::Type_Send) == CC_MqttsnOpType_Publish);
+static_assert(static_cast<unsigned>(Op::Type_Will) == CC_MqttsnOpType_Will);
+static_assert(static_cast<unsigned>(Op::Type_NumOfValues) == CC_MqttsnOpType_ValuesLimit);
+
 } // namespace
 
 bool Op::isValidTopicId(CC_MqttsnTopicId id)
@@ -39,11 +58,42 @@ bool Op::isValidTopicId(CC_MqttsnTopicId id)
     return (id != 0U) && (id != 0xffff);
 }
 
-Op::Op(ClientImpl& client) :
+Op::Op(ClientImpl& client, Type type) :
     m_client(client),
-    m_retryPeriod(client.configState().m_retryPeriod),
-    m_retryCount(client.configState().m_retryCount)
+    m_retryPeriod(client.currentRetryPeriod()),
+    m_retryCount(client.configState().m_retryCount),
+    m_type(type)
+{
+}
+
+void Op::terminateOp(CC_MqttsnAsyncOpStatus status)
 {
+    switch (m_type) {
+        case Type_Search:
+            static_cast<SearchOp*>(this)->terminateOpImpl(status);
+            break;
+        case Type_Connect:
+            static_cast<ConnectOp*>(this)->terminateOpImpl(status);
+            break;
+        case Type_Disconnect:
+            static_cast<DisconnectOp*>(this)->terminateOpImpl(status);
+            break;
+        case Type_Subscribe:
+            static_cast<SubscribeOp*>(this)->terminateOpImpl(status);
+            break;
+        case Type_Unsubscribe:
+            static_cast<UnsubscribeOp*>(this)->terminateOpImpl(status);
+            break;
+        case Type_Send:
+            static_cast<SendOp*>(this)->terminateOpImpl(status);
+            break;
+        case Type_Will:
+            static_cast<WillOp*>(this)->terminateOpImpl(status);
+            break;
+        default:
+            terminateOpImpl(status);
+            break;
+    }
 }
 
 void Op::terminateOpImpl([[maybe_unused]] CC_MqttsnAsyncOpStatus status)
@@ -83,9 +133,16 @@ CC_MqttsnAsyncOpStatus Op::translateErrorCodeToAsyncOpStatus(CC_MqttsnErrorCode
 
 CC_MqttsnErrorCode Op::sendMessage(const ProtMessage& msg, unsigned broadcastRadius)
 {
+    m_client.stats().opMessageSent(*this, m_client.clientState().m_timestamp);
     return m_client.sendMessage(msg, broadcastRadius);
 }
 
+CC_MqttsnErrorCode Op::sendMessage(const ProtMessage& msg, const std::uint8_t* payload, unsigned payloadLen, bool lentPayload)
+{
+    m_client.stats().opMessageSent(*this, m_client.clientState().m_timestamp);
+    return m_client.sendMessage(msg, payload, payloadLen, lentPayload);
+}
+
 void Op::opComplete()
 {
     m_client.opComplete(this);
@@ -93,40 +150,15 @@ void Op::opComplete()
 
 std::uint16_t Op::allocPacketId()
 {
-    static constexpr auto MaxPacketId = std::numeric_limits<std::uint16_t>::max();
-    auto& allocatedPacketIds = m_client.clientState().m_allocatedPacketIds;
-
-    if ((allocatedPacketIds.max_size() <= allocatedPacketIds.size()) ||
-        (MaxPacketId <= allocatedPacketIds.size())) {
+    auto& state = m_client.clientState();
+    auto id = state.m_packetIds.alloc();
+    if (id == 0U) {
         errorLog("No more available packet IDs for allocation");
         return 0U;
     }
 
-    auto& lastPacketId = m_client.clientState().m_lastPacketId;
-    auto nextPacketId = static_cast<std::uint16_t>(lastPacketId + 1U);
-
-    while (true) {
-        if ((nextPacketId == std::numeric_limits<decltype(nextPacketId)>::max()) ||
-            (nextPacketId == 0U)) {
-            nextPacketId = 1U;
-        }
-
-        if (allocatedPacketIds.empty() || (allocatedPacketIds.back() < nextPacketId)) {
-            allocatedPacketIds.push_back(nextPacketId);
-            break;
-        }
-
-        auto iter = std::lower_bound(allocatedPacketIds.begin(), allocatedPacketIds.end(), nextPacketId);
-        if ((iter == allocatedPacketIds.end()) || (*iter != nextPacketId)) {
-            allocatedPacketIds.insert(iter, nextPacketId);
-            break;
-        }
-
-        ++nextPacketId;
-    }
-
-    lastPacketId = static_cast<std::uint16_t>(nextPacketId);
-    return lastPacketId;
+    state.m_msgIdOps.insert(id, this);
+    return id;
 }
 
 void Op::releasePacketId(std::uint16_t id)
@@ -135,21 +167,56 @@ void Op::releasePacketId(std::uint16_t id)
         return;
     }
 
-    auto& allocatedPacketIds = m_client.clientState().m_allocatedPacketIds;
-    auto iter = std::lower_bound(allocatedPacketIds.begin(), allocatedPacketIds.end(), id);
-    if ((iter == allocatedPacketIds.end()) || (*iter != id)) {
+    auto& state = m_client.clientState();
+    if (!state.m_packetIds.release(id)) {
         [[maybe_unused]] static constexpr bool ShouldNotHappen = false;
         COMMS_ASSERT(ShouldNotHappen);
         return;
     }
 
-    allocatedPacketIds.erase(iter);
+    state.m_msgIdOps.erase(id);
 }
 
 void Op::decRetryCount()
 {
     COMMS_ASSERT(m_retryCount > 0U);
     --m_retryCount;
+    ++m_retryAttempt;
+    m_client.stats().opRetry(type());
+}
+
+unsigned Op::getRetryWaitPeriod() const
+{
+    if ((!m_client.configState().m_adaptiveRetryPeriod) || (m_retryAttempt == 0U)) {
+        return m_retryPeriod;
+    }
+
+    // Exponential backoff on retries
+    static constexpr unsigned MaxShift = 16U;
+    auto shift = std::min(m_retryAttempt, MaxShift);
+    auto period = static_cast<std::uint64_t>(m_retryPeriod) << shift;
+    auto maxPeriod = std::max(m_retryPeriod, RttEstimator::MaxRetryPeriodMs);
+    return static_cast<unsigned>(std::min<std::uint64_t>(period, maxPeriod));
+}
+
+void Op::rttMeasureStart()
+{
+    // Karn's algorithm: don't measure the round trip of the retransmitted messages
+    m_rttMeasured = (m_retryAttempt == 0U);
+    m_rttStartTimestamp = m_client.clientState().m_timestamp;
+}
+
+void Op::rttMeasureComplete()
+{
+    if (!m_rttMeasured) {
+        return;
+    }
+
+    m_rttMeasured = false;
+    auto& state = m_client.clientState();
+    COMMS_ASSERT(m_rttStartTimestamp <= state.m_timestamp);
+    auto rtt = std::min<std::uint64_t>(state.m_timestamp - m_rttStartTimestamp, std::numeric_limits<unsigned>::max());
+    state.m_rttEstimator.addSample(static_cast<unsigned>(rtt));
 }
 
 bool Op::isShortTopic(const char* topic)
@@ -9,6 +9,7 @@
 
 #pragma once
 
+#include "ClientStats.h"
 #include "ExtConfig.h"
 #include "ObjListType.h"
 #include "ProtocolDefs.h"
@@ -16,6 +17,8 @@
 
 #include "cc_mqttsn_client/common.h"
 
+#include <cstddef>
+#include <cstdint>
 #include <limits>
 
 namespace cc_mqttsn_client
@@ -26,7 +29,13 @@ class ClientImpl;
 namespace op
 {
 
-class Op : public ProtMsgHandler
+// The operations don't have any virtual functions. All the operation classes
+// are final, the incoming messages are dispatched to them with their actual
+// types (see ClientImpl::dispatchToOps()) and the type specific functionality
+// is selected by the stored operation type.
+// The statistics info is a private base class rather than a data member
+// to occupy no space when the statistics are excluded from the build.
+class Op : private ClientStats::OpInfo
 {
 public:
     enum Type
@@ -44,17 +53,15 @@ public:
 
     using Qos = cc_mqttsn::field::QosCommon::ValueType;
 
-    virtual ~Op() noexcept = default;
-
     Type type() const
     {
-        return typeImpl();
+        return m_type;
     }
 
-    void terminateOp(CC_MqttsnAsyncOpStatus status)
-    {
-        terminateOpImpl(status);
-    }
+    void terminateOp(CC_MqttsnAsyncOpStatus status);
+
+    // The messages not handled by the derived operation are ignored
+    void handle([[maybe_unused]] ProtMessage& msg) {}
 
     unsigned getRetryPeriod() const
     {
@@ -74,6 +81,7 @@ public:
     void setRetryCount(unsigned value)
     {
         m_retryCount = value;
+        m_retryAttempt = 0U;
     }
 
     inline
@@ -87,22 +95,40 @@ public:
         return m_client;
     }
 
+    const ClientStats::OpInfo& statsInfo() const
+    {
+        return *this;
+    }
+
+    std::size_t opsIdx() const
+    {
+        return m_opsIdx;
+    }
+
+    void setOpsIdx(std::size_t idx)
+    {
+        m_opsIdx = idx;
+    }
+
     static bool isValidTopicId(CC_MqttsnTopicId id);
+    static bool isShortTopic(const char* topic);
 
 protected:
-    explicit Op(ClientImpl& client);
+    Op(ClientImpl& client, Type type);
+    ~Op() noexcept = default;
 
-    virtual Type typeImpl() const = 0;
-    virtual void terminateOpImpl(CC_MqttsnAsyncOpStatus status);
+    void terminateOpImpl(CC_MqttsnAsyncOpStatus status);
 
     static CC_MqttsnAsyncOpStatus translateErrorCodeToAsyncOpStatus(CC_MqttsnErrorCode ec);
     CC_MqttsnErrorCode sendMessage(const ProtMessage& msg, unsigned broadcastRadius = 0U);
+    CC_MqttsnErrorCode sendMessage(const ProtMessage& msg, const std::uint8_t* payload, unsigned payloadLen, bool lentPayload);
     void opComplete();
     std::uint16_t allocPacketId();
     void releasePacketId(std::uint16_t id);
     void decRetryCount();
-
-    static bool isShortTopic(const char* topic);
+    unsigned getRetryWaitPeriod() const;
+    void rttMeasureStart();
+    void rttMeasureComplete();
 
     const ClientImpl& client() const
     {
@@ -136,8 +162,13 @@ private:
     bool verifySubFilterInternal(const char* filter);
 
     ClientImpl& m_client;
+    std::uint64_t m_rttStartTimestamp = 0U;
+    std::size_t m_opsIdx = 0U; // Index in the ClientImpl::m_ops list
     unsigned m_retryPeriod = 0U;
     unsigned m_retryCount = 0U;
+    unsigned m_retryAttempt = 0U;
+    Type m_type = Type_NumOfValues; // Stored to avoid virtual call when queried
+    bool m_rttMeasured = false;
 };
 
 } // namespace op
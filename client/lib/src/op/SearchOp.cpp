@@ -36,7 +36,7 @@ inline SearchOp* asSearchOp(void* data)
 } // namespace
 
 SearchOp::SearchOp(ClientImpl& client) :
-    Base(client),
+    Base(client, Type_Search),
     m_timer(client.timerMgr().allocTimer()),
     m_radius(client.configState().m_broadcastRadius)
 {
@@ -111,11 +111,6 @@ void SearchOp::handle(GwinfoMsg& msg)
     completeOpInternal(CC_MqttsnAsyncOpStatus_Complete, &info);
 }
 
-Op::Type SearchOp::typeImpl() const
-{
-    return Type_Search;
-}
-
 void SearchOp::terminateOpImpl(CC_MqttsnAsyncOpStatus status)
 {
     completeOpInternal(status);
@@ -148,6 +143,7 @@ CC_MqttsnErrorCode SearchOp::sendInternal()
 void SearchOp::timeoutInternal()
 {
     if (getRetryCount() == 0U) {
+        client().stats().opTimeout(type());
         errorLog("All retries of the search operation have been exhausted.");
         completeOpInternal(CC_MqttsnAsyncOpStatus_Timeout);
         return;
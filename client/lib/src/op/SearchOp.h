@@ -34,8 +34,8 @@ public:
     CC_MqttsnErrorCode cancel();
 
     using Base::handle;
-    virtual void handle(AdvertiseMsg& msg) override;
-    virtual void handle(GwinfoMsg& msg) override;
+    void handle(AdvertiseMsg& msg);
+    void handle(GwinfoMsg& msg);
 
     void setBroadcastRadius(unsigned value)
     {
@@ -47,11 +47,10 @@ public:
         return m_radius;
     }
 
-protected:
-    virtual Type typeImpl() const override;
-    virtual void terminateOpImpl(CC_MqttsnAsyncOpStatus status) override;
-
 private:
+    friend class Op;
+    void terminateOpImpl(CC_MqttsnAsyncOpStatus status);
+
     void completeOpInternal(CC_MqttsnAsyncOpStatus status, const CC_MqttsnGatewayInfo* info = nullptr);
     void restartTimer();
     CC_MqttsnErrorCode sendInternal();
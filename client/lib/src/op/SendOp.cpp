@@ -39,7 +39,7 @@ inline CC_MqttsnPublishHandle asHandle(SendOp* op)
 } // namespace
 
 SendOp::SendOp(ClientImpl& client) :
-    Base(client),
+    Base(client, Type_Send),
     m_timer(client.timerMgr().allocTimer())
 {
 }
@@ -47,9 +47,12 @@ SendOp::SendOp(ClientImpl& client) :
 SendOp::~SendOp()
 {
     releasePacketIdsInternal();
+    if (m_storage != nullptr) {
+        client().sendOpStoragesAlloc().free(m_storage);
+    }
 }
 
-CC_MqttsnErrorCode SendOp::config(const CC_MqttsnPublishConfig* config)
+CC_MqttsnErrorCode SendOp::config(const CC_MqttsnPublishConfig* config, bool zeroCopy)
 {
     if (config == nullptr) {
         errorLog("Publish configuration is not provided.");
@@ -65,14 +68,9 @@ CC_MqttsnErrorCode SendOp::config(const CC_MqttsnPublishConfig* config)
         return CC_MqttsnErrorCode_BadParam;
     }
 
-    if (static_cast<decltype(config->m_qos)>(Config::MaxQos) < config->m_qos) {
-        errorLog("Bad publish qos value.");
-        return CC_MqttsnErrorCode_BadParam;
-    }
-
-    if ((0U < config->m_dataLen) && (config->m_data == nullptr)) {
-        errorLog("Bad publish message data.");
-        return CC_MqttsnErrorCode_BadParam;
+    auto ec = verifyDataConfig(*config);
+    if (ec != CC_MqttsnErrorCode_Success) {
+        return ec;
     }
 
     if ((!emptyTopic) && (!client().verifyPubTopic(config->m_topic, true))) {
@@ -80,21 +78,15 @@ CC_MqttsnErrorCode SendOp::config(const CC_MqttsnPublishConfig* config)
         return CC_MqttsnErrorCode_BadParam;
     }
 
-    m_publishMsg.field_flags().field_qos().setValue(config->m_qos);
-    m_publishMsg.field_flags().field_mid().setBitValue_Retain(config->m_retain);
-
-    if (0U < config->m_dataLen) {
-        comms::util::assign(m_publishMsg.field_data().value(), config->m_data, config->m_data + config->m_dataLen);
-    }
-    else {
-        m_publishMsg.field_data().value().clear();
+    ec = applyDataConfig(*config, zeroCopy);
+    if (ec != CC_MqttsnErrorCode_Success) {
+        return ec;
     }
 
-    using TopicIdType = PublishMsg::Field_flags::Field_topicIdType::ValueType;
     do {
         if (emptyTopic) {
-            m_publishMsg.field_topicId().setValue(config->m_topicId);
-            m_publishMsg.field_flags().field_topicIdType().value() = TopicIdType::PredefinedTopicId;
+            m_topicId = config->m_topicId;
+            m_topicIdType = TopicIdType::PredefinedTopicId;
             m_stage = Stage_Publish;
             break;
         }
@@ -103,34 +95,33 @@ CC_MqttsnErrorCode SendOp::config(const CC_MqttsnPublishConfig* config)
             auto topicId =
                 (static_cast<std::uint16_t>(config->m_topic[0]) << 8U) |
                 (static_cast<std::uint8_t>(config->m_topic[1]));
-            m_publishMsg.field_topicId().setValue(topicId);
-            m_publishMsg.field_flags().field_topicIdType().value() = TopicIdType::ShortTopicName;
+            m_topicId = static_cast<std::uint16_t>(topicId);
+            m_topicIdType = TopicIdType::ShortTopicName;
             m_stage = Stage_Publish;
             break;
         }
 
-        m_registerMsg.field_topicName().value() = config->m_topic;
-        m_publishMsg.field_flags().field_topicIdType().value() = TopicIdType::Normal;
+        // The topic string is not guaranteed to outlive the operation,
+        // the copy is required for the (re-)registration.
+        ec = applyTopicCopy(config->m_topic);
+        if (ec != CC_MqttsnErrorCode_Success) {
+            return ec;
+        }
+
+        m_topicIdType = TopicIdType::Normal;
 
         auto& outRegMap = client().reuseState().m_outRegTopics;
-        auto outIter =
-            std::lower_bound(
-                outRegMap.begin(), outRegMap.end(), config->m_topic,
-                [](auto& elem, const char* topicParam)
-                {
-                    return elem.m_topic < topicParam;
-                });
-
-        if ((outIter != outRegMap.end()) && (outIter->m_topic == config->m_topic)) {
-            m_publishMsg.field_topicId().setValue(outIter->m_topicId);
+        auto* outInfo = outRegMap.findTopic(config->m_topic);
+        if (outInfo != nullptr) {
+            m_topicId = outInfo->m_topicId;
             m_stage = Stage_Publish;
-            outIter->m_timestamp = client().clientState().m_timestamp;
+            outRegMap.touch(*outInfo);
             break;
         }
 
         auto inTopicId = client().findInRegTopicId(config->m_topic);
         if (inTopicId != 0U) {
-            m_publishMsg.field_topicId().setValue(inTopicId);
+            m_topicId = inTopicId;
             m_stage = Stage_Publish;
             client().storeOutRegTopic(config->m_topic, inTopicId);
             break;
@@ -142,6 +133,45 @@ CC_MqttsnErrorCode SendOp::config(const CC_MqttsnPublishConfig* config)
     return CC_MqttsnErrorCode_Success;
 }
 
+CC_MqttsnErrorCode SendOp::configPrepared(CC_MqttsnPreparedTopic* prepared, const CC_MqttsnPublishConfig* config, bool zeroCopy)
+{
+    if (config == nullptr) {
+        errorLog("Publish configuration is not provided.");
+        return CC_MqttsnErrorCode_BadParam;
+    }
+
+    if ((prepared == nullptr) ||
+        (prepared->m_topic == nullptr) ||
+        (prepared->m_client != &client())) {
+        errorLog("Invalid prepared topic in publish.");
+        return CC_MqttsnErrorCode_BadParam;
+    }
+
+    auto ec = verifyDataConfig(*config);
+    if (ec != CC_MqttsnErrorCode_Success) {
+        return ec;
+    }
+
+    ec = applyDataConfig(*config, zeroCopy);
+    if (ec != CC_MqttsnErrorCode_Success) {
+        return ec;
+    }
+
+    // The topic format has been verified during the preparation and the
+    // prepared topic string outlives the operation, it's never copied.
+    m_topic = prepared->m_topic;
+    if (client().resolvePreparedTopic(*prepared)) {
+        m_topicId = prepared->m_topicId;
+        m_topicIdType = static_cast<TopicIdType>(prepared->m_topicIdType);
+        m_stage = Stage_Publish;
+        return CC_MqttsnErrorCode_Success;
+    }
+
+    m_topicIdType = TopicIdType::Normal;
+    m_stage = Stage_Register;
+    return CC_MqttsnErrorCode_Success;
+}
+
 CC_MqttsnErrorCode SendOp::send(CC_MqttsnPublishCompleteCb cb, void* cbData)
 {
     client().allowNextPrepare();
@@ -198,6 +228,11 @@ void SendOp::resume()
     }
 
     m_suspended = false;
+    if (m_cb == nullptr) {
+        // Still being prepared, will be sent when send() is invoked
+        return;
+    }
+
     auto ec = sendInternal();
     if (ec != CC_MqttsnErrorCode_Success) {
         errorLog("Failed to send SUBSCRIBE, after prev SUBSCRIBE completion");
@@ -212,11 +247,13 @@ void SendOp::handle(RegackMsg& msg)
         return;
     }
 
-    if ((Stage_Register < m_stage) || (msg.field_msgId().value() != m_registerMsg.field_msgId().value())) {
+    if ((Stage_Register < m_stage) || (msg.field_msgId().value() != m_registerMsgId)) {
         errorLog("Unexpected REGACK message, ignoring");
         return;
     }
 
+    rttMeasureComplete();
+
     if (msg.field_returnCode().value() != RegackMsg::Field_returnCode::ValueType::Accepted) {
         auto info = CC_MqttsnPublishInfo();
         comms::cast_assign(info.m_returnCode) = msg.field_returnCode().value();
@@ -230,54 +267,11 @@ void SendOp::handle(RegackMsg& msg)
         return;
     }
 
-    auto& regMap = client().reuseState().m_outRegTopics;
-    auto& topicStr = m_registerMsg.field_topicName().value();
-    COMMS_ASSERT(!topicStr.empty());
-
-    auto findElem =
-        [&regMap, &topicStr]()
-        {
-            return
-                std::lower_bound(
-                    regMap.begin(), regMap.end(), topicStr,
-                    [](auto& elem, auto& topicParam)
-                    {
-                        return elem.m_topic < topicParam;
-                    });
-        };
-
-    auto iter = findElem();
-
-    do {
-        if ((iter != regMap.end()) && (iter->m_topic == topicStr)) {
-            iter->m_timestamp = client().clientState().m_timestamp;
-            iter->m_topicId = topicId;
-            break;
-        }
-
-        auto outRegTopicsLimit = client().clientState().m_outRegTopicsLimit;
-        COMMS_ASSERT(outRegTopicsLimit <= regMap.max_size());
-        if (outRegTopicsLimit <= regMap.size()) {
-            // Already full, need to drop least recently used
-            auto dropIter =
-                std::min_element(
-                    regMap.begin(), regMap.end(),
-                    [](auto& info1, auto& info2)
-                    {
-                        return info1.m_timestamp < info2.m_timestamp;
-                    });
-
-            COMMS_ASSERT(dropIter != regMap.end());
-            regMap.erase(dropIter);
-
-            iter = findElem(); // the insert place may have changed
-        }
-
-        regMap.emplace(iter, client().clientState().m_timestamp, topicStr.c_str(), topicId);
-    } while (false);
+    COMMS_ASSERT(m_topic != nullptr);
+    client().storeOutRegTopic(m_topic, topicId);
 
     m_stage = Stage_Publish;
-    m_publishMsg.field_topicId().setValue(topicId);
+    m_topicId = topicId;
     setRetryCount(m_origRetryCount);
     auto ec = sendInternal();
     if (ec != CC_MqttsnErrorCode_Success) {
@@ -290,8 +284,8 @@ void SendOp::handle(PubackMsg& msg)
 {
     if ((m_suspended) ||
         (m_stage < Stage_Publish) ||
-        (msg.field_msgId().value() != m_publishMsg.field_msgId().value()) ||
-        (msg.field_topicId().value() != m_publishMsg.field_topicId().value()))  {
+        (msg.field_msgId().value() != m_publishMsgId) ||
+        (msg.field_topicId().value() != m_topicId))  {
         return;
     }
 
@@ -299,25 +293,24 @@ void SendOp::handle(PubackMsg& msg)
     info.m_returnCode = static_cast<decltype(info.m_returnCode)>(msg.field_returnCode().value());
 
     if ((info.m_returnCode == CC_MqttsnReturnCode_Accepted) &&
-        (m_publishMsg.field_flags().field_qos().value() != Qos::AtLeastOnceDelivery)) {
+        (m_qos != Qos::AtLeastOnceDelivery)) {
         errorLog("Received PUBACK instead of PUBREC, ignoring...");
         return;
     }
 
+    rttMeasureComplete();
+
     auto status = CC_MqttsnAsyncOpStatus_Complete;
     do {
         if (info.m_returnCode != CC_MqttsnReturnCode_InvalidTopicId) {
             break;
         }
 
-        using TopicIdType = PublishMsg::Field_flags::Field_topicIdType::ValueType;
-        auto topicIdType = m_publishMsg.field_flags().field_topicIdType().value();
-
-        if (topicIdType == TopicIdType::PredefinedTopicId) {
+        if (m_topicIdType == TopicIdType::PredefinedTopicId) {
             break;
         }
 
-        if (topicIdType != TopicIdType::Normal) {
+        if (m_topicIdType != TopicIdType::Normal) {
             errorLog("Unexpected return code for the publish");
             break;
         }
@@ -328,8 +321,9 @@ void SendOp::handle(PubackMsg& msg)
         }
 
         --m_fullRetryRemCount;
+        COMMS_ASSERT(m_topic != nullptr);
         m_stage = Stage_Register;
-        m_publishMsg.field_flags().field_high().setBitValue_Dup(false); // Make sure it's not reported as duplicate
+        m_dup = false; // Make sure it's not reported as duplicate
 
         // Re-allocate new packet IDs
         releasePacketIdsInternal();
@@ -353,15 +347,17 @@ void SendOp::handle(PubrecMsg& msg)
 {
     if ((m_suspended) ||
         (m_stage < Stage_Publish) ||
-        (msg.field_msgId().value() != m_publishMsg.field_msgId().value()))  {
+        (msg.field_msgId().value() != m_publishMsgId))  {
         return;
     }
 
-    if (m_publishMsg.field_flags().field_qos().value() != Qos::ExactlyOnceDelivery) {
+    if (m_qos != Qos::ExactlyOnceDelivery) {
         errorLog("Received PUBREC instead of PUBACK, ignoring...");
         return;
     }
 
+    rttMeasureComplete();
+
     m_stage = Stage_Acked;
     setRetryCount(m_origRetryCount);
     auto ec = sendInternal();
@@ -375,20 +371,17 @@ void SendOp::handle(PubcompMsg& msg)
 {
     if ((m_suspended) ||
         (m_stage < Stage_Acked) ||
-        (msg.field_msgId().value() != m_publishMsg.field_msgId().value()))  {
+        (msg.field_msgId().value() != m_publishMsgId))  {
         return;
     }
 
+    rttMeasureComplete();
+
     completeOpInternal(CC_MqttsnAsyncOpStatus_Complete);
 }
 
 #endif // #if CC_MQTTSN_CLIENT_MAX_QOS >=2
 
-Op::Type SendOp::typeImpl() const
-{
-    return Type_Send;
-}
-
 void SendOp::terminateOpImpl(CC_MqttsnAsyncOpStatus status)
 {
     completeOpInternal(status);
@@ -411,7 +404,8 @@ void SendOp::completeOpInternal(CC_MqttsnAsyncOpStatus status, const CC_MqttsnPu
 
 void SendOp::restartTimer()
 {
-    m_timer.wait(getRetryPeriod(), &SendOp::opTimeoutCb, this);
+    m_timer.wait(getRetryWaitPeriod(), &SendOp::opTimeoutCb, this);
+    rttMeasureStart();
 }
 
 CC_MqttsnErrorCode SendOp::sendInternal()
@@ -437,7 +431,11 @@ CC_MqttsnErrorCode SendOp::sendInternal()
 
 CC_MqttsnErrorCode SendOp::sendInternal_Register()
 {
-    auto ec = sendMessage(m_registerMsg);
+    RegisterMsg registerMsg;
+    registerMsg.field_msgId().setValue(m_registerMsgId);
+    registerMsg.field_topicName().value() = m_topic;
+
+    auto ec = sendMessage(registerMsg);
     if (ec == CC_MqttsnErrorCode_Success) {
         restartTimer();
     }
@@ -448,26 +446,37 @@ CC_MqttsnErrorCode SendOp::sendInternal_Register()
 CC_MqttsnErrorCode SendOp::sendInternal_Publish()
 {
     COMMS_ASSERT(
-        (m_publishMsg.field_flags().field_topicIdType().value() == PublishMsg::Field_flags::Field_topicIdType::ValueType::ShortTopicName) ||
-        (isValidTopicId(m_publishMsg.field_topicId().value())));
+        (m_topicIdType == TopicIdType::ShortTopicName) ||
+        (isValidTopicId(m_topicId)));
 
     if constexpr (0 < Config::MaxQos) {
         if (getRetryCount() < m_origRetryCount) {
-            m_publishMsg.field_flags().field_high().setBitValue_Dup(true);
+            m_dup = true;
         }
     }
 
-    auto ec = sendMessage(m_publishMsg);
+    // The payload is not part of the built message, it is appended
+    // from the owned (or lent) data while being sent.
+    PublishMsg publishMsg;
+    auto& flagsField = publishMsg.field_flags();
+    flagsField.field_topicIdType().value() = m_topicIdType;
+    flagsField.field_qos().value() = m_qos;
+    flagsField.field_mid().setBitValue_Retain(m_retain);
+    flagsField.field_high().setBitValue_Dup(m_dup);
+    publishMsg.field_topicId().setValue(m_topicId);
+    publishMsg.field_msgId().setValue(m_publishMsgId);
+
+    auto ec = sendMessage(publishMsg, m_data, m_dataLen, !m_dataOwned);
     if (ec != CC_MqttsnErrorCode_Success) {
         return ec;
     }
 
-    if (Qos::AtMostOnceDelivery == m_publishMsg.field_flags().field_qos().value()) {
+    if (Qos::AtMostOnceDelivery == m_qos) {
         completeOpInternal(CC_MqttsnAsyncOpStatus_Complete);
         return CC_MqttsnErrorCode_Success;
     }
 
-    COMMS_ASSERT(m_publishMsg.field_msgId().value() > 0U);
+    COMMS_ASSERT(m_publishMsgId > 0U);
     restartTimer();
     return CC_MqttsnErrorCode_Success;
 }
@@ -476,7 +485,7 @@ CC_MqttsnErrorCode SendOp::sendInternal_Pubrel()
 {
     if constexpr (2 <= Config::MaxQos) {
         PubrelMsg pubrelMsg;
-        pubrelMsg.field_msgId().setValue(m_publishMsg.field_msgId().value());
+        pubrelMsg.field_msgId().setValue(m_publishMsgId);
         auto ec = sendMessage(pubrelMsg);
         if (ec == CC_MqttsnErrorCode_Success) {
             restartTimer();
@@ -492,6 +501,7 @@ CC_MqttsnErrorCode SendOp::sendInternal_Pubrel()
 void SendOp::timeoutInternal()
 {
     if (getRetryCount() == 0U) {
+        client().stats().opTimeout(type());
         errorLog("All retries of the publish operation have been exhausted.");
         completeOpInternal(CC_MqttsnAsyncOpStatus_Timeout);
         return;
@@ -511,21 +521,90 @@ void SendOp::opTimeoutCb(void* data)
     asSendOp(data)->timeoutInternal();
 }
 
+CC_MqttsnErrorCode SendOp::verifyDataConfig(const CC_MqttsnPublishConfig& config)
+{
+    if (static_cast<decltype(config.m_qos)>(Config::MaxQos) < config.m_qos) {
+        errorLog("Bad publish qos value.");
+        return CC_MqttsnErrorCode_BadParam;
+    }
+
+    if ((0U < config.m_dataLen) && (config.m_data == nullptr)) {
+        errorLog("Bad publish message data.");
+        return CC_MqttsnErrorCode_BadParam;
+    }
+
+    return CC_MqttsnErrorCode_Success;
+}
+
+CC_MqttsnErrorCode SendOp::applyDataConfig(const CC_MqttsnPublishConfig& config, bool zeroCopy)
+{
+    m_qos = static_cast<Qos>(config.m_qos);
+    m_retain = config.m_retain;
+    m_dataOwned = false;
+
+    if (zeroCopy || (config.m_dataLen == 0U)) {
+        // The data is lent by the application until the operation is complete
+        m_data = config.m_data;
+        m_dataLen = config.m_dataLen;
+        return CC_MqttsnErrorCode_Success;
+    }
+
+    if (!allocStorageIfNeeded()) {
+        return CC_MqttsnErrorCode_OutOfMemory;
+    }
+
+    auto& dataStorage = m_storage->m_data;
+    comms::util::assign(dataStorage, config.m_data, config.m_data + config.m_dataLen);
+    m_data = dataStorage.data();
+    m_dataLen = static_cast<unsigned>(dataStorage.size());
+    m_dataOwned = true;
+    return CC_MqttsnErrorCode_Success;
+}
+
+CC_MqttsnErrorCode SendOp::applyTopicCopy(const char* topic)
+{
+    if (!allocStorageIfNeeded()) {
+        return CC_MqttsnErrorCode_OutOfMemory;
+    }
+
+    auto& topicStorage = m_storage->m_topic;
+    topicStorage = topic;
+    m_topic = topicStorage.c_str();
+    return CC_MqttsnErrorCode_Success;
+}
+
+bool SendOp::allocStorageIfNeeded()
+{
+    if (m_storage != nullptr) {
+        return true;
+    }
+
+    // The raw pointer is stored to avoid the deleter overhead, the storage
+    // is released in the destructor.
+    m_storage = client().sendOpStoragesAlloc().alloc().release();
+    if (m_storage == nullptr) {
+        errorLog("Failed to allocate publish topic / data storage.");
+        return false;
+    }
+
+    return true;
+}
+
 void SendOp::allocPacketIdsInternal()
 {
     if (m_stage == Stage_Register) {
-        m_registerMsg.field_msgId().setValue(allocPacketId());
+        m_registerMsgId = allocPacketId();
     }
 
-    if (Qos::AtMostOnceDelivery < m_publishMsg.field_flags().field_qos().value()) {
-        m_publishMsg.field_msgId().setValue(allocPacketId());
+    if (Qos::AtMostOnceDelivery < m_qos) {
+        m_publishMsgId = allocPacketId();
     }
 }
 
 void SendOp::releasePacketIdsInternal()
 {
-    releasePacketId(m_registerMsg.field_msgId().value());
-    releasePacketId(m_publishMsg.field_msgId().value());
+    releasePacketId(m_registerMsgId);
+    releasePacketId(m_publishMsgId);
 }
 
 } // namespace op
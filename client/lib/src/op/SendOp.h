@@ -11,6 +11,7 @@
 
 #include "op/Op.h"
 #include "ExtConfig.h"
+#include "ObjAllocator.h"
 #include "ProtocolDefs.h"
 
 #include "TimerMgr.h"
@@ -21,15 +22,29 @@ namespace cc_mqttsn_client
 namespace op
 {
 
+// Copy of the topic and / or data owned by the publish operation, allocated
+// only when the operation cannot refer to the memory provided by the application.
+struct SendOpStorage
+{
+    using TopicNameStr = RegisterMsg::Field_topicName::ValueType;
+    using DataStorage = PublishMsg::Field_data::ValueType;
+
+    TopicNameStr m_topic;
+    DataStorage m_data;
+};
+
+using SendOpStorageAlloc = ObjAllocator<SendOpStorage, ExtConfig::SendOpStoragesLimit>;
+
 class SendOp final : public Op
 {
     using Base = Op;
 public:
 
     explicit SendOp(ClientImpl& client);
-    virtual ~SendOp();
+    ~SendOp();
 
-    CC_MqttsnErrorCode config(const CC_MqttsnPublishConfig* config);
+    CC_MqttsnErrorCode config(const CC_MqttsnPublishConfig* config, bool zeroCopy = false);
+    CC_MqttsnErrorCode configPrepared(CC_MqttsnPreparedTopic* prepared, const CC_MqttsnPublishConfig* config, bool zeroCopy = false);
     CC_MqttsnErrorCode send(CC_MqttsnPublishCompleteCb cb, void* cbData);
     CC_MqttsnErrorCode cancel();
     void proceedWithReg();
@@ -41,24 +56,30 @@ public:
 
     void resume();
 
+    bool isSuspended() const
+    {
+        return m_suspended;
+    }
+
     std::uint16_t publishMsgId() const
     {
-        return m_publishMsg.field_msgId().value();
+        return m_publishMsgId;
     }
 
     using Base::handle;
-    void handle(RegackMsg& msg) override;
-    void handle(PubackMsg& msg) override;
+    void handle(RegackMsg& msg);
+    void handle(PubackMsg& msg);
 #if CC_MQTTSN_CLIENT_MAX_QOS >=2
-    void handle(PubrecMsg& msg) override;
-    void handle(PubcompMsg& msg) override;
+    void handle(PubrecMsg& msg);
+    void handle(PubcompMsg& msg);
 #endif // CC_MQTTSN_CLIENT_MAX_QOS >=2
 
-protected:
-    virtual Type typeImpl() const override;
-    virtual void terminateOpImpl(CC_MqttsnAsyncOpStatus status) override;
-
 private:
+    friend class Op;
+    void terminateOpImpl(CC_MqttsnAsyncOpStatus status);
+
+    using TopicIdType = PublishMsg::Field_flags::Field_topicIdType::ValueType;
+
     enum Stage
     {
         Stage_Register,
@@ -67,6 +88,10 @@ private:
         Stage_ValuesLimit
     };
 
+    CC_MqttsnErrorCode verifyDataConfig(const CC_MqttsnPublishConfig& config);
+    CC_MqttsnErrorCode applyDataConfig(const CC_MqttsnPublishConfig& config, bool zeroCopy);
+    CC_MqttsnErrorCode applyTopicCopy(const char* topic);
+    bool allocStorageIfNeeded();
     void completeOpInternal(CC_MqttsnAsyncOpStatus status, const CC_MqttsnPublishInfo* info = nullptr);
     void restartTimer();
     CC_MqttsnErrorCode sendInternal();
@@ -79,14 +104,28 @@ private:
 
     static void opTimeoutCb(void* data);
 
-    RegisterMsg m_registerMsg;
-    PublishMsg m_publishMsg;
+    // Only the information required for the (re)transmission is stored,
+    // the REGISTER and PUBLISH messages are built on demand when sent.
+    // The topic and data refer either to the memory provided by the
+    // application (prepared topic, zero copy data) or to the owned storage.
+    SendOpStorage* m_storage = nullptr;
     TimerMgr::Timer m_timer;
+    const char* m_topic = nullptr;
+    const std::uint8_t* m_data = nullptr;
+    unsigned m_dataLen = 0U;
     CC_MqttsnPublishCompleteCb m_cb = nullptr;
     void* m_cbData = nullptr;
     Stage m_stage = Stage_Register;
     unsigned m_origRetryCount = 0U;
     unsigned m_fullRetryRemCount = 0U;
+    std::uint16_t m_topicId = 0U;
+    std::uint16_t m_registerMsgId = 0U;
+    std::uint16_t m_publishMsgId = 0U;
+    TopicIdType m_topicIdType = TopicIdType::Normal;
+    Qos m_qos = Qos::AtMostOnceDelivery;
+    bool m_retain = false;
+    bool m_dup = false;
+    bool m_dataOwned = false;
     bool m_suspended = false;
 
     static_assert(ExtConfig::SendOpTimers == 1U);
@@ -39,7 +39,7 @@ inline CC_MqttsnSubscribeHandle asHandle(SubscribeOp* op)
 } // namespace
 
 SubscribeOp::SubscribeOp(ClientImpl& client) :
-    Base(client),
+    Base(client, Type_Subscribe),
     m_timer(client.timerMgr().allocTimer())
 {
 }
@@ -152,6 +152,7 @@ void SubscribeOp::handle(SubackMsg& msg)
     }
 
     m_timer.cancel();
+    rttMeasureComplete();
 
     auto info = CC_MqttsnSubscribeInfo();
     info.m_returnCode = static_cast<decltype(info.m_returnCode)>(msg.field_returnCode().value());
@@ -182,37 +183,17 @@ void SubscribeOp::handle(SubackMsg& msg)
         client().storeInRegTopic(topicPtr, topicId);
     }
 
-    auto& filtersMap = client().reuseState().m_subFilters;
-    do {
+    if constexpr (Config::HasSubTopicVerification) {
+        auto& subFilters = client().reuseState().m_subFilters;
         if (topicPtr != nullptr) {
-            auto iter =
-                std::lower_bound(
-                    filtersMap.begin(), filtersMap.end(), topicPtr,
-                    [](auto& elem, const char* topicParam)
-                    {
-                        return elem.m_topic < topicParam;
-                    });
-
-            if ((iter == filtersMap.end()) || (iter->m_topic != topicPtr)) {
-                filtersMap.emplace(iter, topicPtr);
-            }
-
-            break;
+            subFilters.addTopic(topicPtr);
         }
-
-        COMMS_ASSERT(m_subscribeMsg.field_topicId().doesExist());
-        COMMS_ASSERT(m_subscribeMsg.field_topicId().field().value() != 0U);
-
-        auto iter =
-            std::find_if(
-                filtersMap.begin(), filtersMap.end(),
-                [](auto& elem)
-                {
-                    return !elem.m_topic.empty();
-                });
-
-        filtersMap.emplace(iter, static_cast<CC_MqttsnTopicId>(m_subscribeMsg.field_topicId().field().value()));
-    } while (false);
+        else {
+            COMMS_ASSERT(m_subscribeMsg.field_topicId().doesExist());
+            COMMS_ASSERT(m_subscribeMsg.field_topicId().field().value() != 0U);
+            subFilters.addTopicId(static_cast<CC_MqttsnTopicId>(m_subscribeMsg.field_topicId().field().value()));
+        }
+    }
 
     completeOpInternal(CC_MqttsnAsyncOpStatus_Complete, &info);
 }
@@ -232,11 +213,6 @@ void SubscribeOp::resume()
     }
 }
 
-Op::Type SubscribeOp::typeImpl() const
-{
-    return Type_Subscribe;
-}
-
 void SubscribeOp::terminateOpImpl(CC_MqttsnAsyncOpStatus status)
 {
     completeOpInternal(status);
@@ -255,7 +231,8 @@ void SubscribeOp::completeOpInternal(CC_MqttsnAsyncOpStatus status, const CC_Mqt
 
 void SubscribeOp::restartTimer()
 {
-    m_timer.wait(getRetryPeriod(), &SubscribeOp::opTimeoutCb, this);
+    m_timer.wait(getRetryWaitPeriod(), &SubscribeOp::opTimeoutCb, this);
+    rttMeasureStart();
 }
 
 CC_MqttsnErrorCode SubscribeOp::sendInternal()
@@ -275,6 +252,7 @@ CC_MqttsnErrorCode SubscribeOp::sendInternal()
 void SubscribeOp::timeoutInternal()
 {
     if (getRetryCount() == 0U) {
+        client().stats().opTimeout(type());
         errorLog("All retries of the subscribe operation have been exhausted.");
         completeOpInternal(CC_MqttsnAsyncOpStatus_Timeout);
         return;
@@ -26,14 +26,14 @@ class SubscribeOp final : public Op
     using Base = Op;
 public:
     explicit SubscribeOp(ClientImpl& client);
-    virtual ~SubscribeOp();
+    ~SubscribeOp();
 
     CC_MqttsnErrorCode config(const CC_MqttsnSubscribeConfig* config);
     CC_MqttsnErrorCode send(CC_MqttsnSubscribeCompleteCb cb, void* cbData);
     CC_MqttsnErrorCode cancel();
 
     using Base::handle;
-    void handle(SubackMsg& msg) override;
+    void handle(SubackMsg& msg);
 
     void suspend()
     {
@@ -42,11 +42,10 @@ public:
 
     void resume();
 
-protected:
-    virtual Type typeImpl() const override;
-    virtual void terminateOpImpl(CC_MqttsnAsyncOpStatus status) override;
-
 private:
+    friend class Op;
+    void terminateOpImpl(CC_MqttsnAsyncOpStatus status);
+
     void completeOpInternal(CC_MqttsnAsyncOpStatus status, const CC_MqttsnSubscribeInfo* info = nullptr);
     void restartTimer();
     CC_MqttsnErrorCode sendInternal();
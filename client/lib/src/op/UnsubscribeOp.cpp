@@ -39,7 +39,7 @@ inline CC_MqttsnUnsubscribeHandle asHandle(UnsubscribeOp* op)
 } // namespace
 
 UnsubscribeOp::UnsubscribeOp(ClientImpl& client) :
-    Base(client),
+    Base(client, Type_Unsubscribe),
     m_timer(client.timerMgr().allocTimer())
 {
 }
@@ -76,17 +76,9 @@ CC_MqttsnErrorCode UnsubscribeOp::config(const CC_MqttsnUnsubscribeConfig* confi
                 break;
             }
 
-            auto& filtersMap = client().reuseState().m_subFilters;
+            auto& subFilters = client().reuseState().m_subFilters;
             if (!emptyTopic) {
-                auto iter =
-                    std::lower_bound(
-                        filtersMap.begin(), filtersMap.end(), config->m_topic,
-                        [](auto& elem, const char* topicParam)
-                        {
-                            return elem.m_topic < topicParam;
-                        });
-
-                if ((iter == filtersMap.end()) || (iter->m_topic != config->m_topic)) {
+                if (!subFilters.hasTopic(config->m_topic)) {
                     errorLog("Requested unsubscribe topic hasn't been used for subscription before");
                     return CC_MqttsnErrorCode_BadParam;
                 }
@@ -95,15 +87,7 @@ CC_MqttsnErrorCode UnsubscribeOp::config(const CC_MqttsnUnsubscribeConfig* confi
             }
 
             COMMS_ASSERT(isValidTopicId(config->m_topicId));
-            auto iter =
-                std::find_if(
-                    filtersMap.begin(), filtersMap.end(),
-                    [config](auto& elem)
-                    {
-                        return config->m_topicId == elem.m_topicId;
-                    });
-
-            if (iter == filtersMap.end()) {
+            if (!subFilters.hasTopicId(config->m_topicId)) {
                 errorLog("Requested unsubscribe topic ID hasn't been used for subscription before");
                 return CC_MqttsnErrorCode_BadParam;
             }
@@ -180,37 +164,14 @@ CC_MqttsnErrorCode UnsubscribeOp::send(CC_MqttsnUnsubscribeCompleteCb cb, void*
     client().removeInRegTopic(topicPtr, topicId);
 
     if constexpr (Config::HasSubTopicVerification) {
-        do {
-            auto& filtersMap = client().reuseState().m_subFilters;
-            if (topicPtr != nullptr) {
-                auto iter =
-                    std::lower_bound(
-                        filtersMap.begin(), filtersMap.end(), topicPtr,
-                        [](auto& elem, const char* topicParam)
-                        {
-                            return elem.m_topic < topicParam;
-                        });
-
-                if ((iter != filtersMap.end()) && (iter->m_topic != topicPtr)) {
-                    filtersMap.erase(iter);
-                }
-
-                break;
-            }
-
+        auto& subFilters = client().reuseState().m_subFilters;
+        if (topicPtr != nullptr) {
+            subFilters.removeTopic(topicPtr);
+        }
+        else {
             COMMS_ASSERT(topicId != 0U);
-
-            auto iter =
-                std::find_if(
-                    filtersMap.begin(), filtersMap.end(),
-                    [topicId](auto& elem) {
-                        return elem.m_topicId == topicId;
-                    });
-
-            if (iter != filtersMap.end()) {
-                filtersMap.erase(iter);
-            }
-        } while (false);
+            subFilters.removeTopicId(topicId);
+        }
     }
 
     completeOnError.release();
@@ -235,6 +196,7 @@ void UnsubscribeOp::handle(UnsubackMsg& msg)
     }
 
     m_timer.cancel();
+    rttMeasureComplete();
     completeOpInternal(CC_MqttsnAsyncOpStatus_Complete);
 }
 
@@ -253,11 +215,6 @@ void UnsubscribeOp::resume()
     }
 }
 
-Op::Type UnsubscribeOp::typeImpl() const
-{
-    return Type_Unsubscribe;
-}
-
 void UnsubscribeOp::terminateOpImpl(CC_MqttsnAsyncOpStatus status)
 {
     completeOpInternal(status);
@@ -276,7 +233,8 @@ void UnsubscribeOp::completeOpInternal(CC_MqttsnAsyncOpStatus status)
 
 void UnsubscribeOp::restartTimer()
 {
-    m_timer.wait(getRetryPeriod(), &UnsubscribeOp::opTimeoutCb, this);
+    m_timer.wait(getRetryWaitPeriod(), &UnsubscribeOp::opTimeoutCb, this);
+    rttMeasureStart();
 }
 
 CC_MqttsnErrorCode UnsubscribeOp::sendInternal()
@@ -296,6 +254,7 @@ CC_MqttsnErrorCode UnsubscribeOp::sendInternal()
 void UnsubscribeOp::timeoutInternal()
 {
     if (getRetryCount() == 0U) {
+        client().stats().opTimeout(type());
         errorLog("All retries of the unsubscribe operation have been exhausted.");
         completeOpInternal(CC_MqttsnAsyncOpStatus_Timeout);
         return;
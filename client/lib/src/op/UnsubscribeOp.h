@@ -26,14 +26,14 @@ class UnsubscribeOp final : public Op
     using Base = Op;
 public:
     explicit UnsubscribeOp(ClientImpl& client);
-    virtual ~UnsubscribeOp();
+    ~UnsubscribeOp();
 
     CC_MqttsnErrorCode config(const CC_MqttsnUnsubscribeConfig* config);
     CC_MqttsnErrorCode send(CC_MqttsnUnsubscribeCompleteCb cb, void* cbData);
     CC_MqttsnErrorCode cancel();
 
     using Base::handle;
-    void handle(UnsubackMsg& msg) override;
+    void handle(UnsubackMsg& msg);
 
     void suspend()
     {
@@ -42,11 +42,10 @@ public:
 
     void resume();
 
-protected:
-    virtual Type typeImpl() const override;
-    virtual void terminateOpImpl(CC_MqttsnAsyncOpStatus status) override;
-
 private:
+    friend class Op;
+    void terminateOpImpl(CC_MqttsnAsyncOpStatus status);
+
     void completeOpInternal(CC_MqttsnAsyncOpStatus status);
     void restartTimer();
     CC_MqttsnErrorCode sendInternal();
@@ -45,7 +45,7 @@ CC_MqttsnWillInfo initWillInfo()
 } // namespace
 
 WillOp::WillOp(ClientImpl& client) :
-    Base(client),
+    Base(client, Type_Will),
     m_timer(client.timerMgr().allocTimer()),
     m_info(initWillInfo())
 {
@@ -209,11 +209,6 @@ void WillOp::handle(WillmsgrespMsg& msg)
     completeOpInternal(CC_MqttsnAsyncOpStatus_Complete, &info);
 }
 
-Op::Type WillOp::typeImpl() const
-{
-    return Type_Will;
-}
-
 void WillOp::terminateOpImpl(CC_MqttsnAsyncOpStatus status)
 {
     completeOpInternal(status);
@@ -231,7 +226,7 @@ void WillOp::completeOpInternal(CC_MqttsnAsyncOpStatus status, const CC_MqttsnWi
 
 void WillOp::restartTimer()
 {
-    m_timer.wait(getRetryPeriod(), &WillOp::opTimeoutCb, this);
+    m_timer.wait(getRetryWaitPeriod(), &WillOp::opTimeoutCb, this);
 }
 
 CC_MqttsnErrorCode WillOp::sendInternal()
@@ -261,6 +256,7 @@ CC_MqttsnErrorCode WillOp::sendInternal()
 void WillOp::timeoutInternal()
 {
     if (getRetryCount() == 0U) {
+        client().stats().opTimeout(type());
         errorLog("All retries of the will operation have been exhausted.");
         completeOpInternal(CC_MqttsnAsyncOpStatus_Timeout);
         return;
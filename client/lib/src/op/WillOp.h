@@ -34,14 +34,13 @@ public:
     CC_MqttsnErrorCode cancel();
 
     using Base::handle;
-    void handle(WilltopicrespMsg& msg) override;
-    void handle(WillmsgrespMsg& msg) override;
-
-protected:
-    virtual Type typeImpl() const override;
-    virtual void terminateOpImpl(CC_MqttsnAsyncOpStatus status) override;
+    void handle(WilltopicrespMsg& msg);
+    void handle(WillmsgrespMsg& msg);
 
 private:
+    friend class Op;
+    void terminateOpImpl(CC_MqttsnAsyncOpStatus status);
+
     enum Stage : unsigned
     {
         Stage_willTopic,
@@ -2,6 +2,7 @@
 
 #include "comms/iterator.h"
 
+#include <algorithm>
 #include <cassert>
 #include <iostream>
 
@@ -27,12 +28,21 @@ UnitTestCommonBase::UnitTestCommonBase(const LibFuncs& funcs) :
 {
     test_assert(m_funcs.m_alloc != nullptr);
     test_assert(m_funcs.m_free != nullptr);
+    test_assert(m_funcs.m_set_alloc_callbacks != nullptr);
+    test_assert(m_funcs.m_set_ops_slab_limit != nullptr);
     test_assert(m_funcs.m_tick != nullptr);
     test_assert(m_funcs.m_process_data != nullptr);
+    test_assert(m_funcs.m_process_data_batch != nullptr);
+    test_assert(m_funcs.m_rx_ring_push != nullptr);
+    test_assert(m_funcs.m_rx_ring_drain != nullptr);
     test_assert(m_funcs.m_set_default_retry_period != nullptr);
     test_assert(m_funcs.m_get_default_retry_period != nullptr);
     test_assert(m_funcs.m_set_default_retry_count != nullptr);
     test_assert(m_funcs.m_get_default_retry_count != nullptr);
+    test_assert(m_funcs.m_set_adaptive_retry_period_enabled != nullptr);
+    test_assert(m_funcs.m_get_adaptive_retry_period_enabled != nullptr);
+    test_assert(m_funcs.m_get_rtt_estimate != nullptr);
+    test_assert(m_funcs.m_get_retry_period_estimate != nullptr);
     test_assert(m_funcs.m_set_default_broadcast_radius != nullptr);
     test_assert(m_funcs.m_init_gateway_info != nullptr);
     test_assert(m_funcs.m_get_available_gateway_info != nullptr);
@@ -53,6 +63,10 @@ UnitTestCommonBase::UnitTestCommonBase(const LibFuncs& funcs) :
     test_assert(m_funcs.m_get_outgoing_topic_id_storage_limit != nullptr);
     test_assert(m_funcs.m_set_incoming_topic_id_storage_limit != nullptr);
     test_assert(m_funcs.m_get_incoming_topic_id_storage_limit != nullptr);
+    test_assert(m_funcs.m_set_inflight_publishes_limit != nullptr);
+    test_assert(m_funcs.m_get_inflight_publishes_limit != nullptr);
+    test_assert(m_funcs.m_get_stats != nullptr);
+    test_assert(m_funcs.m_reset_stats != nullptr);
     test_assert(m_funcs.m_asleep_check_messages != nullptr);
     test_assert(m_funcs.m_search_prepare != nullptr);
     test_assert(m_funcs.m_search_set_retry_period != nullptr);
@@ -112,9 +126,14 @@ UnitTestCommonBase::UnitTestCommonBase(const LibFuncs& funcs) :
     test_assert(m_funcs.m_publish_get_retry_count != nullptr);
     test_assert(m_funcs.m_publish_init_config != nullptr);
     test_assert(m_funcs.m_publish_config != nullptr);
+    test_assert(m_funcs.m_publish_config_zero_copy != nullptr);
+    test_assert(m_funcs.m_prepare_topic != nullptr);
+    test_assert(m_funcs.m_publish_config_prepared != nullptr);
     test_assert(m_funcs.m_publish_send != nullptr);
     test_assert(m_funcs.m_publish_cancel != nullptr);
     test_assert(m_funcs.m_publish != nullptr);
+    test_assert(m_funcs.m_publish_qos0 != nullptr);
+    test_assert(m_funcs.m_publish_batch != nullptr);
     test_assert(m_funcs.m_will_prepare != nullptr);
     test_assert(m_funcs.m_will_set_retry_period != nullptr);
     test_assert(m_funcs.m_will_get_retry_period != nullptr);
@@ -137,7 +156,10 @@ UnitTestCommonBase::UnitTestCommonBase(const LibFuncs& funcs) :
     test_assert(m_funcs.m_sleep != nullptr);
     test_assert(m_funcs.m_set_next_tick_program_callback != nullptr);
     test_assert(m_funcs.m_set_cancel_next_tick_wait_callback != nullptr);
+    test_assert(m_funcs.m_set_clock_callback != nullptr);
     test_assert(m_funcs.m_set_send_output_data_callback != nullptr);
+    test_assert(m_funcs.m_set_send_output_segments_callback != nullptr);
+    test_assert(m_funcs.m_set_output_buffer_callbacks != nullptr);
     test_assert(m_funcs.m_set_gw_status_report_callback != nullptr);
     test_assert(m_funcs.m_set_gw_disconnect_report_callback != nullptr);
     test_assert(m_funcs.m_set_message_report_callback != nullptr);
@@ -151,6 +173,15 @@ UnitTestCommonBase::UnitTestOutputDataInfo::UnitTestOutputDataInfo(const std::ui
 {
 }
 
+UnitTestCommonBase::UnitTestOutputDataInfo::UnitTestOutputDataInfo(const CC_MqttsnOutputSegment* segments, unsigned count, unsigned broadcastRadius) :
+    m_broadcastRadius(broadcastRadius),
+    m_segmentsCount(count)
+{
+    for (auto idx = 0U; idx < count; ++idx) {
+        m_data.insert(m_data.end(), segments[idx].m_data, segments[idx].m_data + segments[idx].m_dataLen);
+    }
+}
+
 UnitTestCommonBase::UnitTestGwInfo& UnitTestCommonBase::UnitTestGwInfo::operator=(const CC_MqttsnGatewayInfo& info)
 {
     m_gwId = info.m_gwId;
@@ -302,12 +333,49 @@ void UnitTestCommonBase::unitTestAssignCallbacks(CC_MqttsnClient* client, bool e
 
 }
 
+void UnitTestCommonBase::unitTestEnableOutputSegments(CC_MqttsnClient* client)
+{
+    test_assert(client != nullptr);
+    m_funcs.m_set_send_output_segments_callback(client, &UnitTestCommonBase::unitTestSendOutputSegmentsCb, this);
+}
+
+void UnitTestCommonBase::unitTestEnableOutputBuffer(CC_MqttsnClient* client)
+{
+    test_assert(client != nullptr);
+    m_funcs.m_set_output_buffer_callbacks(
+        client,
+        &UnitTestCommonBase::unitTestGetOutputBufferCb,
+        &UnitTestCommonBase::unitTestCommitOutputBufferCb,
+        this);
+}
+
+void UnitTestCommonBase::unitTestDisableOutputBuffer(CC_MqttsnClient* client, bool getBufCbOnly)
+{
+    test_assert(client != nullptr);
+    CC_MqttsnCommitOutputBufferCb commitCb = nullptr;
+    if (getBufCbOnly) {
+        commitCb = &UnitTestCommonBase::unitTestCommitOutputBufferCb;
+    }
+
+    m_funcs.m_set_output_buffer_callbacks(client, nullptr, commitCb, this);
+}
+
+void UnitTestCommonBase::unitTestSetOutputBufferAvailable(bool available)
+{
+    m_data.m_outBufAvailable = available;
+}
+
 void UnitTestCommonBase::unitTestClientInputData(CC_MqttsnClient* client, const UnitTestData& data, CC_MqttsnDataOrigin origin)
 {
     apiProcessData(client, data.data(), static_cast<unsigned>(data.size()), origin);
 }
 
 void UnitTestCommonBase::unitTestClientInputMessage(CC_MqttsnClient* client, const UnitTestMessage& msg, CC_MqttsnDataOrigin origin)
+{
+    unitTestClientInputData(client, unitTestSerializeMessage(msg), origin);
+}
+
+UnitTestCommonBase::UnitTestData UnitTestCommonBase::unitTestSerializeMessage(const UnitTestMessage& msg)
 {
     UnitTestData data;
     UnitTestsFrame frame;
@@ -315,7 +383,7 @@ void UnitTestCommonBase::unitTestClientInputMessage(CC_MqttsnClient* client, con
     auto writeIter = comms::writeIteratorFor<UnitTestMessage>(data.data());
     auto ec = frame.write(msg, writeIter, data.size());
     test_assert(ec == comms::ErrorStatus::Success);
-    unitTestClientInputData(client, data, origin);
+    return data;
 }
 
 void UnitTestCommonBase::unitTestPushSearchgwResponseDelay(unsigned val)
@@ -347,6 +415,11 @@ const UnitTestCommonBase::UnitTestTickInfo* UnitTestCommonBase::unitTestTickInfo
     return &m_data.m_ticks.front();
 }
 
+unsigned UnitTestCommonBase::unitTestTickProgramsCount() const
+{
+    return m_data.m_tickProgramsCount;
+}
+
 void UnitTestCommonBase::unitTestTick(CC_MqttsnClient* client, unsigned ms)
 {
     test_assert(!m_data.m_ticks.empty());
@@ -355,6 +428,18 @@ void UnitTestCommonBase::unitTestTick(CC_MqttsnClient* client, unsigned ms)
         ms = info.m_req;
     }
 
+    if (m_data.m_clockEnabled) {
+        // The elapsed time is reported via the clock, relative to the last tick programming
+        m_data.m_clockMs = std::max(m_data.m_clockMs, m_data.m_clockProgramMs + ms);
+        if (ms < info.m_req) {
+            return;
+        }
+
+        m_data.m_ticks.pop_front();
+        m_funcs.m_tick(client, 0U);
+        return;
+    }
+
     if (ms < info.m_req) {
         info.m_elapsed = ms;
         return;
@@ -365,6 +450,13 @@ void UnitTestCommonBase::unitTestTick(CC_MqttsnClient* client, unsigned ms)
     m_funcs.m_tick(client, msToReport);
 }
 
+void UnitTestCommonBase::unitTestEnableClock(CC_MqttsnClient* client)
+{
+    test_assert(client != nullptr);
+    m_data.m_clockEnabled = true;
+    m_funcs.m_set_clock_callback(client, &UnitTestCommonBase::unitTestClockCb, this);
+}
+
 bool UnitTestCommonBase::unitTestHasOutputData() const
 {
     return !m_data.m_outData.empty();
@@ -919,6 +1011,16 @@ CC_MqttsnErrorCode UnitTestCommonBase::unitTestPublishSend(CC_MqttsnPublishHandl
     return m_funcs.m_publish_send(publish, &UnitTestCommonBase::unitTestPublishCompleteCb, this);
 }
 
+unsigned UnitTestCommonBase::unitTestPublishBatch(CC_MqttsnClient* client, CC_MqttsnPublishRequest* requests, unsigned count)
+{
+    for (auto idx = 0U; idx < count; ++idx) {
+        requests[idx].m_cb = &UnitTestCommonBase::unitTestPublishCompleteCb;
+        requests[idx].m_cbData = this;
+    }
+
+    return m_funcs.m_publish_batch(client, requests, count);
+}
+
 bool UnitTestCommonBase::unitTestHasWillCompleteReport() const
 {
     return !m_data.m_willCompleteReports.empty();
@@ -985,6 +1087,31 @@ void UnitTestCommonBase::apiProcessData(CC_MqttsnClient* client, const unsigned
     m_funcs.m_process_data(client, buf, bufLen, origin);
 }
 
+unsigned UnitTestCommonBase::apiProcessDataBatch(CC_MqttsnClient* client, CC_MqttsnInputData* inputs, unsigned count)
+{
+    return m_funcs.m_process_data_batch(client, inputs, count);
+}
+
+CC_MqttsnErrorCode UnitTestCommonBase::apiRxRingPush(CC_MqttsnClient* client, const unsigned char* buf, unsigned bufLen, CC_MqttsnDataOrigin origin)
+{
+    return m_funcs.m_rx_ring_push(client, buf, bufLen, origin);
+}
+
+unsigned UnitTestCommonBase::apiRxRingDrain(CC_MqttsnClient* client)
+{
+    return m_funcs.m_rx_ring_drain(client);
+}
+
+CC_MqttsnErrorCode UnitTestCommonBase::apiSetAllocCallbacks(CC_MqttsnAllocCb allocCb, CC_MqttsnFreeCb freeCb, void* data)
+{
+    return m_funcs.m_set_alloc_callbacks(allocCb, freeCb, data);
+}
+
+CC_MqttsnErrorCode UnitTestCommonBase::apiSetOpsSlabLimit(CC_MqttsnClient* client, unsigned limit)
+{
+    return m_funcs.m_set_ops_slab_limit(client, limit);
+}
+
 CC_MqttsnErrorCode UnitTestCommonBase::apiSetDefaultRetryPeriod(CC_MqttsnClient* client, unsigned value)
 {
     return m_funcs.m_set_default_retry_period(client, value);
@@ -1005,6 +1132,26 @@ unsigned UnitTestCommonBase::apiGetDefaultRetryCount(CC_MqttsnClientHandle clien
     return m_funcs.m_get_default_retry_count(client);
 }
 
+CC_MqttsnErrorCode UnitTestCommonBase::apiSetAdaptiveRetryPeriodEnabled(CC_MqttsnClientHandle client, bool enabled)
+{
+    return m_funcs.m_set_adaptive_retry_period_enabled(client, enabled);
+}
+
+bool UnitTestCommonBase::apiGetAdaptiveRetryPeriodEnabled(CC_MqttsnClientHandle client)
+{
+    return m_funcs.m_get_adaptive_retry_period_enabled(client);
+}
+
+unsigned UnitTestCommonBase::apiGetRttEstimate(CC_MqttsnClientHandle client)
+{
+    return m_funcs.m_get_rtt_estimate(client);
+}
+
+unsigned UnitTestCommonBase::apiGetRetryPeriodEstimate(CC_MqttsnClientHandle client)
+{
+    return m_funcs.m_get_retry_period_estimate(client);
+}
+
 CC_MqttsnErrorCode UnitTestCommonBase::apiSetVerifyIncomingMsgSubscribed(CC_MqttsnClient* client, bool enabled)
 {
     return m_funcs.m_set_verify_incoming_msg_subscribed(client, enabled);
@@ -1030,6 +1177,26 @@ CC_MqttsnErrorCode UnitTestCommonBase::apiSetIncomingTopicIdStorageLimit(CC_Mqtt
     return m_funcs.m_set_incoming_topic_id_storage_limit(client, limit);
 }
 
+CC_MqttsnErrorCode UnitTestCommonBase::apiSetInflightPublishesLimit(CC_MqttsnClient* client, unsigned limit)
+{
+    return m_funcs.m_set_inflight_publishes_limit(client, limit);
+}
+
+unsigned UnitTestCommonBase::apiGetInflightPublishesLimit(CC_MqttsnClient* client)
+{
+    return m_funcs.m_get_inflight_publishes_limit(client);
+}
+
+CC_MqttsnErrorCode UnitTestCommonBase::apiGetStats(CC_MqttsnClientHandle client, CC_MqttsnClientStats* stats)
+{
+    return m_funcs.m_get_stats(client, stats);
+}
+
+CC_MqttsnErrorCode UnitTestCommonBase::apiResetStats(CC_MqttsnClientHandle client)
+{
+    return m_funcs.m_reset_stats(client);
+}
+
 CC_MqttsnSearchHandle UnitTestCommonBase::apiSearchPrepare(CC_MqttsnClient* client, CC_MqttsnErrorCode* ec)
 {
     return m_funcs.m_search_prepare(client, ec);
@@ -1098,6 +1265,15 @@ CC_MqttsnErrorCode UnitTestCommonBase::apiDisconnectSetRetryCount(CC_MqttsnDisco
 void UnitTestCommonBase::unitTestTickProgramCb(void* data, unsigned duration)
 {
     auto* thisPtr = asThis(data);
+    ++thisPtr->m_data.m_tickProgramsCount;
+    if (thisPtr->m_data.m_clockEnabled) {
+        // The new programming replaces the previous one
+        thisPtr->m_data.m_ticks.clear();
+        thisPtr->m_data.m_ticks.emplace_back(duration);
+        thisPtr->m_data.m_clockProgramMs = thisPtr->m_data.m_clockMs;
+        return;
+    }
+
     if (thisPtr->m_data.m_ticks.empty()) {
         asThis(data)->m_data.m_ticks.emplace_back(duration);
         return;
@@ -1117,12 +1293,47 @@ unsigned UnitTestCommonBase::unitTestCancelTickWaitCb(void* data)
     return result;
 }
 
+unsigned long long UnitTestCommonBase::unitTestClockCb(void* data)
+{
+    return asThis(data)->m_data.m_clockMs;
+}
+
 void UnitTestCommonBase::unitTestSendOutputDataCb(void* data, const unsigned char* buf, unsigned bufLen, unsigned broadcastRadius)
 {
     auto* thisPtr = asThis(data);
     thisPtr->m_data.m_outData.emplace_back(buf, bufLen, broadcastRadius);
 }
 
+void UnitTestCommonBase::unitTestSendOutputSegmentsCb(void* data, const CC_MqttsnOutputSegment* segments, unsigned count, unsigned broadcastRadius)
+{
+    auto* thisPtr = asThis(data);
+    thisPtr->m_data.m_outData.emplace_back(segments, count, broadcastRadius);
+}
+
+unsigned char* UnitTestCommonBase::unitTestGetOutputBufferCb(void* data, unsigned bufLen)
+{
+    auto* thisPtr = asThis(data);
+    test_assert(thisPtr->m_data.m_outBuf.empty());
+    if (!thisPtr->m_data.m_outBufAvailable) {
+        return nullptr;
+    }
+
+    thisPtr->m_data.m_outBuf.resize(bufLen);
+    return thisPtr->m_data.m_outBuf.data();
+}
+
+void UnitTestCommonBase::unitTestCommitOutputBufferCb(void* data, unsigned char* buf, unsigned bufLen, unsigned broadcastRadius)
+{
+    auto* thisPtr = asThis(data);
+    test_assert(buf == thisPtr->m_data.m_outBuf.data());
+    test_assert(bufLen <= thisPtr->m_data.m_outBuf.size());
+    if (0U < bufLen) {
+        thisPtr->m_data.m_outData.emplace_back(buf, bufLen, broadcastRadius);
+    }
+
+    thisPtr->m_data.m_outBuf.clear();
+}
+
 void UnitTestCommonBase::unitTestGwStatusReportCb(void* data, CC_MqttsnGwStatus status, const CC_MqttsnGatewayInfo* info)
 {
     asThis(data)->m_data.m_gwInfoReports.push_back(std::make_unique<UnitTestGwInfoReport>(status, info));
@@ -1203,11 +1414,36 @@ CC_MqttsnErrorCode UnitTestCommonBase::apiPublishConfig(CC_MqttsnPublishHandle p
     return m_funcs.m_publish_config(publish, config);
 }
 
+CC_MqttsnErrorCode UnitTestCommonBase::apiPublishConfigZeroCopy(CC_MqttsnPublishHandle publish, const CC_MqttsnPublishConfig* config)
+{
+    return m_funcs.m_publish_config_zero_copy(publish, config);
+}
+
+CC_MqttsnErrorCode UnitTestCommonBase::apiPrepareTopic(CC_MqttsnClient* client, const char* topic, CC_MqttsnPreparedTopic* prepared)
+{
+    return m_funcs.m_prepare_topic(client, topic, prepared);
+}
+
+CC_MqttsnErrorCode UnitTestCommonBase::apiPublishConfigPrepared(CC_MqttsnPublishHandle publish, CC_MqttsnPreparedTopic* prepared, const CC_MqttsnPublishConfig* config)
+{
+    return m_funcs.m_publish_config_prepared(publish, prepared, config);
+}
+
 CC_MqttsnErrorCode UnitTestCommonBase::apiPublishCancel(CC_MqttsnPublishHandle publish)
 {
     return m_funcs.m_publish_cancel(publish);
 }
 
+CC_MqttsnErrorCode UnitTestCommonBase::apiPublishQos0(CC_MqttsnClient* client, const CC_MqttsnPublishConfig* config)
+{
+    return m_funcs.m_publish_qos0(client, config);
+}
+
+decltype(UnitTestCommonBase::LibFuncs::m_publish_batch) UnitTestCommonBase::apiPublishBatchFunc() const
+{
+    return m_funcs.m_publish_batch;
+}
+
 CC_MqttsnWillHandle UnitTestCommonBase::apiWillPrepare(CC_MqttsnClient* client, CC_MqttsnErrorCode* ec)
 {
     return m_funcs.m_will_prepare(client, ec);
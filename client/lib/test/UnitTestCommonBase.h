@@ -16,12 +16,21 @@ public:
     {
         CC_MqttsnClientHandle (*m_alloc)() = nullptr;
         void (*m_free)(CC_MqttsnClientHandle) = nullptr;
+        CC_MqttsnErrorCode (*m_set_alloc_callbacks)(CC_MqttsnAllocCb, CC_MqttsnFreeCb, void*) = nullptr;
+        CC_MqttsnErrorCode (*m_set_ops_slab_limit)(CC_MqttsnClientHandle, unsigned) = nullptr;
         void (*m_tick)(CC_MqttsnClientHandle, unsigned) = nullptr;
         void (*m_process_data)(CC_MqttsnClientHandle, const unsigned char*, unsigned, CC_MqttsnDataOrigin) = nullptr;
+        unsigned (*m_process_data_batch)(CC_MqttsnClientHandle, CC_MqttsnInputData*, unsigned) = nullptr;
+        CC_MqttsnErrorCode (*m_rx_ring_push)(CC_MqttsnClientHandle, const unsigned char*, unsigned, CC_MqttsnDataOrigin) = nullptr;
+        unsigned (*m_rx_ring_drain)(CC_MqttsnClientHandle) = nullptr;
         CC_MqttsnErrorCode (*m_set_default_retry_period)(CC_MqttsnClientHandle, unsigned) = nullptr;
         unsigned (*m_get_default_retry_period)(CC_MqttsnClientHandle) = nullptr;
         CC_MqttsnErrorCode (*m_set_default_retry_count)(CC_MqttsnClientHandle, unsigned) = nullptr;
         unsigned (*m_get_default_retry_count)(CC_MqttsnClientHandle) = nullptr;
+        CC_MqttsnErrorCode (*m_set_adaptive_retry_period_enabled)(CC_MqttsnClientHandle, bool) = nullptr;
+        bool (*m_get_adaptive_retry_period_enabled)(CC_MqttsnClientHandle) = nullptr;
+        unsigned (*m_get_rtt_estimate)(CC_MqttsnClientHandle) = nullptr;
+        unsigned (*m_get_retry_period_estimate)(CC_MqttsnClientHandle) = nullptr;
         CC_MqttsnErrorCode (*m_set_default_broadcast_radius)(CC_MqttsnClientHandle, unsigned) = nullptr;
         unsigned (*m_get_default_broadcast_radius)(CC_MqttsnClientHandle) = nullptr;
         unsigned (*m_get_available_gateways_count)(CC_MqttsnClientHandle) = nullptr;
@@ -44,6 +53,10 @@ public:
         unsigned long long (*m_get_outgoing_topic_id_storage_limit)(CC_MqttsnClientHandle) = nullptr;
         CC_MqttsnErrorCode (*m_set_incoming_topic_id_storage_limit)(CC_MqttsnClientHandle, unsigned long long) = nullptr;
         unsigned long long (*m_get_incoming_topic_id_storage_limit)(CC_MqttsnClientHandle) = nullptr;
+        CC_MqttsnErrorCode (*m_set_inflight_publishes_limit)(CC_MqttsnClientHandle, unsigned) = nullptr;
+        unsigned (*m_get_inflight_publishes_limit)(CC_MqttsnClientHandle) = nullptr;
+        CC_MqttsnErrorCode (*m_get_stats)(CC_MqttsnClientHandle, CC_MqttsnClientStats*) = nullptr;
+        CC_MqttsnErrorCode (*m_reset_stats)(CC_MqttsnClientHandle) = nullptr;
         CC_MqttsnErrorCode (*m_asleep_check_messages)(CC_MqttsnClientHandle client) = nullptr;
         CC_MqttsnSearchHandle (*m_search_prepare)(CC_MqttsnClientHandle, CC_MqttsnErrorCode*) = nullptr;
         CC_MqttsnErrorCode (*m_search_set_retry_period)(CC_MqttsnSearchHandle, unsigned) = nullptr;
@@ -103,9 +116,14 @@ public:
         unsigned (*m_publish_get_retry_count)(CC_MqttsnPublishHandle) = nullptr;
         void (*m_publish_init_config)(CC_MqttsnPublishConfig*) = nullptr;
         CC_MqttsnErrorCode (*m_publish_config)(CC_MqttsnPublishHandle, const CC_MqttsnPublishConfig*) = nullptr;
+        CC_MqttsnErrorCode (*m_publish_config_zero_copy)(CC_MqttsnPublishHandle, const CC_MqttsnPublishConfig*) = nullptr;
+        CC_MqttsnErrorCode (*m_prepare_topic)(CC_MqttsnClientHandle, const char*, CC_MqttsnPreparedTopic*) = nullptr;
+        CC_MqttsnErrorCode (*m_publish_config_prepared)(CC_MqttsnPublishHandle, CC_MqttsnPreparedTopic*, const CC_MqttsnPublishConfig*) = nullptr;
         CC_MqttsnErrorCode (*m_publish_send)(CC_MqttsnPublishHandle, CC_MqttsnPublishCompleteCb, void*) = nullptr;
         CC_MqttsnErrorCode (*m_publish_cancel)(CC_MqttsnPublishHandle) = nullptr;
         CC_MqttsnErrorCode (*m_publish)(CC_MqttsnClientHandle, const CC_MqttsnPublishConfig*, CC_MqttsnPublishCompleteCb, void* cbData) = nullptr;
+        CC_MqttsnErrorCode (*m_publish_qos0)(CC_MqttsnClientHandle, const CC_MqttsnPublishConfig*) = nullptr;
+        unsigned (*m_publish_batch)(CC_MqttsnClientHandle, CC_MqttsnPublishRequest*, unsigned) = nullptr;
         CC_MqttsnWillHandle (*m_will_prepare)(CC_MqttsnClientHandle, CC_MqttsnErrorCode*) = nullptr;
         CC_MqttsnErrorCode (*m_will_set_retry_period)(CC_MqttsnWillHandle, unsigned) = nullptr;
         unsigned (*m_will_get_retry_period)(CC_MqttsnWillHandle) = nullptr;
@@ -128,7 +146,10 @@ public:
         CC_MqttsnErrorCode (*m_sleep)(CC_MqttsnClientHandle, const CC_MqttsnSleepConfig*, CC_MqttsnSleepCompleteCb, void* cbData) = nullptr;
         void (*m_set_next_tick_program_callback)(CC_MqttsnClientHandle, CC_MqttsnNextTickProgramCb, void*) = nullptr;
         void (*m_set_cancel_next_tick_wait_callback)(CC_MqttsnClientHandle, CC_MqttsnCancelNextTickWaitCb, void*) = nullptr;
+        void (*m_set_clock_callback)(CC_MqttsnClientHandle, CC_MqttsnClockCb, void*) = nullptr;
         void (*m_set_send_output_data_callback)(CC_MqttsnClientHandle, CC_MqttsnSendOutputDataCb, void*) = nullptr;
+        void (*m_set_send_output_segments_callback)(CC_MqttsnClientHandle, CC_MqttsnSendOutputSegmentsCb, void*) = nullptr;
+        void (*m_set_output_buffer_callbacks)(CC_MqttsnClientHandle, CC_MqttsnGetOutputBufferCb, CC_MqttsnCommitOutputBufferCb, void*) = nullptr;
         void (*m_set_gw_status_report_callback)(CC_MqttsnClientHandle, CC_MqttsnGwStatusReportCb, void*) = nullptr;
         void (*m_set_gw_disconnect_report_callback)(CC_MqttsnClientHandle, CC_MqttsnGwDisconnectedReportCb, void*) = nullptr;
         void (*m_set_message_report_callback)(CC_MqttsnClientHandle, CC_MqttsnMessageReportCb, void*) = nullptr;
@@ -168,8 +189,10 @@ public:
     {
         UnitTestData m_data;
         unsigned m_broadcastRadius = 0U;
+        unsigned m_segmentsCount = 1U;
 
         UnitTestOutputDataInfo(const std::uint8_t* buf, unsigned bufLen, unsigned broadcastRadius);
+        UnitTestOutputDataInfo(const CC_MqttsnOutputSegment* segments, unsigned count, unsigned broadcastRadius);
     };
 
     using UnitTestOutputDataInfosList = std::list<UnitTestOutputDataInfo>;
@@ -381,15 +404,22 @@ public:
 
     UnitTestClientPtr unitTestAllocClient(bool enableLog = false);
     void unitTestAssignCallbacks(CC_MqttsnClient* client, bool enableLog = false);
+    void unitTestEnableOutputSegments(CC_MqttsnClient* client);
+    void unitTestEnableOutputBuffer(CC_MqttsnClient* client);
+    void unitTestDisableOutputBuffer(CC_MqttsnClient* client, bool getBufCbOnly = false);
+    void unitTestSetOutputBufferAvailable(bool available);
     void unitTestClientInputData(CC_MqttsnClient* client, const UnitTestData& data, CC_MqttsnDataOrigin origin);
     void unitTestClientInputMessage(CC_MqttsnClient* client, const UnitTestMessage& msg, CC_MqttsnDataOrigin origin = CC_MqttsnDataOrigin_ConnectedGw);
+    static UnitTestData unitTestSerializeMessage(const UnitTestMessage& msg);
     void unitTestPushSearchgwResponseDelay(unsigned val);
 
     static CC_MqttsnTopicId unitTestShortTopicNameToId(const std::string& topic);
 
     bool unitTestHasTickReq() const;
     const UnitTestTickInfo* unitTestTickInfo(bool mustExist = true) const;
+    unsigned unitTestTickProgramsCount() const;
     void unitTestTick(CC_MqttsnClient* client, unsigned ms = 0U);
+    void unitTestEnableClock(CC_MqttsnClient* client);
 
     bool unitTestHasOutputData() const;
     const UnitTestOutputDataInfo* unitTestOutputDataInfo(bool mustExist = true) const;
@@ -441,6 +471,7 @@ public:
 
     void unitTestDoPublish(CC_MqttsnClient* client, const CC_MqttsnPublishConfig* config, const UnitTestPublishResponseConfig* respConfig = nullptr);
     CC_MqttsnErrorCode unitTestPublishSend(CC_MqttsnPublishHandle publish);
+    unsigned unitTestPublishBatch(CC_MqttsnClient* client, CC_MqttsnPublishRequest* requests, unsigned count);
 
     bool unitTestHasWillCompleteReport() const;
     UnitTestWillCompleteReportPtr unitTestWillCompleteReport(bool mustExist = true);
@@ -456,15 +487,28 @@ public:
     UnitTestMessageInfoPtr unitTestReceivedMessage(bool mustExist = true);
 
     void apiProcessData(CC_MqttsnClient* client, const unsigned char* buf, unsigned bufLen, CC_MqttsnDataOrigin origin);
+    unsigned apiProcessDataBatch(CC_MqttsnClient* client, CC_MqttsnInputData* inputs, unsigned count);
+    CC_MqttsnErrorCode apiRxRingPush(CC_MqttsnClient* client, const unsigned char* buf, unsigned bufLen, CC_MqttsnDataOrigin origin);
+    unsigned apiRxRingDrain(CC_MqttsnClient* client);
+    CC_MqttsnErrorCode apiSetAllocCallbacks(CC_MqttsnAllocCb allocCb, CC_MqttsnFreeCb freeCb, void* data);
+    CC_MqttsnErrorCode apiSetOpsSlabLimit(CC_MqttsnClient* client, unsigned limit);
     CC_MqttsnErrorCode apiSetDefaultRetryPeriod(CC_MqttsnClient* client, unsigned value);
     unsigned apiGetDefaultRetryPeriod(CC_MqttsnClientHandle client);
     CC_MqttsnErrorCode apiSetDefaultRetryCount(CC_MqttsnClient* client, unsigned value);
     unsigned apiGetDefaultRetryCount(CC_MqttsnClientHandle client);
+    CC_MqttsnErrorCode apiSetAdaptiveRetryPeriodEnabled(CC_MqttsnClientHandle client, bool enabled);
+    bool apiGetAdaptiveRetryPeriodEnabled(CC_MqttsnClientHandle client);
+    unsigned apiGetRttEstimate(CC_MqttsnClientHandle client);
+    unsigned apiGetRetryPeriodEstimate(CC_MqttsnClientHandle client);
     CC_MqttsnErrorCode apiSetVerifyIncomingMsgSubscribed(CC_MqttsnClient* client, bool enabled);
     void apiInitGatewayInfo(CC_MqttsnGatewayInfo* info);
     CC_MqttsnErrorCode apiSetAvailableGatewayInfo(CC_MqttsnClient* client, const CC_MqttsnGatewayInfo* info);
     CC_MqttsnErrorCode apiSetOutgoingTopicIdStorageLimit(CC_MqttsnClient* client, unsigned long long limit);
     CC_MqttsnErrorCode apiSetIncomingTopicIdStorageLimit(CC_MqttsnClient* client, unsigned long long limit);
+    CC_MqttsnErrorCode apiSetInflightPublishesLimit(CC_MqttsnClient* client, unsigned limit);
+    unsigned apiGetInflightPublishesLimit(CC_MqttsnClient* client);
+    CC_MqttsnErrorCode apiGetStats(CC_MqttsnClientHandle client, CC_MqttsnClientStats* stats);
+    CC_MqttsnErrorCode apiResetStats(CC_MqttsnClientHandle client);
 
     CC_MqttsnSearchHandle apiSearchPrepare(CC_MqttsnClient* client, CC_MqttsnErrorCode* ec = nullptr);
     CC_MqttsnErrorCode apiSearchSetRetryPeriod(CC_MqttsnSearchHandle search, unsigned value);
@@ -498,7 +542,12 @@ public:
     CC_MqttsnErrorCode apiPublishSetRetryCount(CC_MqttsnPublishHandle publish, unsigned count);
     void apiPublishInitConfig(CC_MqttsnPublishConfig* config);
     CC_MqttsnErrorCode apiPublishConfig(CC_MqttsnPublishHandle publish, const CC_MqttsnPublishConfig* config);
+    CC_MqttsnErrorCode apiPublishConfigZeroCopy(CC_MqttsnPublishHandle publish, const CC_MqttsnPublishConfig* config);
+    CC_MqttsnErrorCode apiPrepareTopic(CC_MqttsnClient* client, const char* topic, CC_MqttsnPreparedTopic* prepared);
+    CC_MqttsnErrorCode apiPublishConfigPrepared(CC_MqttsnPublishHandle publish, CC_MqttsnPreparedTopic* prepared, const CC_MqttsnPublishConfig* config);
     CC_MqttsnErrorCode apiPublishCancel(CC_MqttsnPublishHandle publish);
+    CC_MqttsnErrorCode apiPublishQos0(CC_MqttsnClient* client, const CC_MqttsnPublishConfig* config);
+    decltype(LibFuncs::m_publish_batch) apiPublishBatchFunc() const;
 
     CC_MqttsnWillHandle apiWillPrepare(CC_MqttsnClient* client, CC_MqttsnErrorCode* ec = nullptr);
     CC_MqttsnErrorCode apiWillSetRetryCount(CC_MqttsnWillHandle will, unsigned count);
@@ -519,7 +568,13 @@ private:
     struct ClientData
     {
         UnitTestTickInfosList m_ticks;
+        unsigned m_tickProgramsCount = 0U;
+        unsigned long long m_clockMs = 0U;
+        unsigned long long m_clockProgramMs = 0U;
+        bool m_clockEnabled = false;
         UnitTestOutputDataInfosList m_outData;
+        UnitTestData m_outBuf;
+        bool m_outBufAvailable = true;
         UnitTestGwInfoReportsList m_gwInfoReports;
         UnitTestGwDisconnectReportsList m_gwDisconnectReports;
         UnitTestSearchCompleteReportsList m_searchCompleteReports;
@@ -537,7 +592,11 @@ private:
 
     static void unitTestTickProgramCb(void* data, unsigned duration);
     static unsigned unitTestCancelTickWaitCb(void* data);
+    static unsigned long long unitTestClockCb(void* data);
     static void unitTestSendOutputDataCb(void* data, const unsigned char* buf, unsigned bufLen, unsigned broadcastRadius);
+    static void unitTestSendOutputSegmentsCb(void* data, const CC_MqttsnOutputSegment* segments, unsigned count, unsigned broadcastRadius);
+    static unsigned char* unitTestGetOutputBufferCb(void* data, unsigned bufLen);
+    static void unitTestCommitOutputBufferCb(void* data, unsigned char* buf, unsigned bufLen, unsigned broadcastRadius);
     static void unitTestGwStatusReportCb(void* data, CC_MqttsnGwStatus status, const CC_MqttsnGatewayInfo* info);
     static void unitTestGwDisconnectReportCb(void* data, CC_MqttsnGatewayDisconnectReason reason);
     static void unitTestMessageReportCb(void* data, const CC_MqttsnMessageInfo* msgInfo);
@@ -0,0 +1,96 @@
+#pragma once
+
+#include "ClientImpl.h"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace bench
+{
+
+using ClientImpl = cc_mqttsn_client::ClientImpl;
+using ClientPtr = std::unique_ptr<ClientImpl>;
+using DataBuf = std::vector<std::uint8_t>;
+
+struct OutputSink
+{
+    DataBuf m_buf;
+    std::size_t m_bytes = 0U;
+    std::uint8_t m_last = 0U;
+};
+
+inline void sendOutputDataCb(void* data, const unsigned char* buf, unsigned bufLen, [[maybe_unused]] unsigned broadcastRadius)
+{
+    // Simulate the transport reading the whole frame
+    auto* sink = reinterpret_cast<OutputSink*>(data);
+    for (auto idx = 0U; idx < bufLen; ++idx) {
+        sink->m_last ^= buf[idx];
+    }
+    sink->m_bytes += bufLen;
+}
+
+inline void messageReceivedCb(void* data, [[maybe_unused]] const CC_MqttsnMessageInfo* info)
+{
+    if (data != nullptr) {
+        ++(*reinterpret_cast<std::size_t*>(data));
+    }
+}
+
+inline void gwDisconnectedCb([[maybe_unused]] void* data, [[maybe_unused]] CC_MqttsnGatewayDisconnectReason reason)
+{
+}
+
+inline void connectCompleteCb([[maybe_unused]] void* data, [[maybe_unused]] CC_MqttsnAsyncOpStatus status, [[maybe_unused]] const CC_MqttsnConnectInfo* info)
+{
+}
+
+// Serialize the message as it is expected to be received from the gateway
+inline bool writeFrame(const cc_mqttsn_client::ProtMessage& msg, DataBuf& buf)
+{
+    cc_mqttsn_client::ProtFrame frame;
+    buf.resize(frame.length(msg));
+    auto writeIter = comms::writeIteratorFor<cc_mqttsn_client::ProtMessage>(buf.data());
+    return frame.write(msg, writeIter, buf.size()) == comms::ErrorStatus::Success;
+}
+
+// The number of the reported messages is accumulated in the receivedCount (if provided)
+inline ClientPtr allocConnectedClient(OutputSink& sink, std::size_t* receivedCount = nullptr)
+{
+    auto client = std::make_unique<ClientImpl>();
+    client->setSendOutputDataCallback(&sendOutputDataCb, &sink);
+    client->setMessageReceivedCallback(&messageReceivedCb, receivedCount);
+    client->setGatewayDisconnectedReportCallback(&gwDisconnectedCb, nullptr);
+
+    auto ec = CC_MqttsnErrorCode_Success;
+    auto* connect = client->connectPrepare(&ec);
+    if (connect == nullptr) {
+        return ClientPtr();
+    }
+
+    auto config = CC_MqttsnConnectConfig();
+    config.m_clientId = "bench";
+    config.m_duration = cc_mqttsn_client::ClientState::DefaultKeepAlive;
+    config.m_cleanSession = true;
+    if ((connect->config(&config) != CC_MqttsnErrorCode_Success) ||
+        (connect->send(&connectCompleteCb, nullptr) != CC_MqttsnErrorCode_Success)) {
+        return ClientPtr();
+    }
+
+    cc_mqttsn_client::ConnackMsg connackMsg;
+    connackMsg.field_returnCode().value() = cc_mqttsn_client::ConnackMsg::Field_returnCode::ValueType::Accepted;
+
+    DataBuf buf;
+    if (!writeFrame(connackMsg, buf)) {
+        return ClientPtr();
+    }
+
+    client->processData(buf.data(), static_cast<unsigned>(buf.size()), CC_MqttsnDataOrigin_ConnectedGw);
+    if (client->sessionState().m_connectionStatus != CC_MqttsnConnectionStatus_Connected) {
+        return ClientPtr();
+    }
+
+    return client;
+}
+
+} // namespace bench
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+namespace bench
+{
+
+using Clock = std::chrono::steady_clock;
+
+template <typename TFunc>
+double measureNsPerIter(std::size_t iterations, TFunc&& func)
+{
+    auto start = Clock::now();
+    for (std::size_t idx = 0U; idx < iterations; ++idx) {
+        func(idx);
+    }
+    auto end = Clock::now();
+    auto diff = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    return static_cast<double>(diff) / static_cast<double>(iterations);
+}
+
+inline void report(const std::string& name, std::size_t param, double nsPerIter)
+{
+    std::cout <<
+        std::left << std::setw(48) << name <<
+        std::right << std::setw(10) << param <<
+        std::setw(14) << std::fixed << std::setprecision(1) << nsPerIter << " ns/iter" << std::endl;
+}
+
+// Simple and deterministic pseudo-random generator to avoid dependency on the std::random
+inline std::uint32_t nextRand(std::uint32_t& state)
+{
+    state = (state * 1103515245U) + 12345U;
+    return (state >> 8);
+}
+
+// Prevent the compiler from optimizing away the measured computation
+template <typename T>
+void doNotOptimize(T value)
+{
+    static volatile T Sink = T();
+    Sink = value;
+    static_cast<void>(Sink);
+}
+
+} // namespace bench
@@ -0,0 +1,381 @@
+#include "BenchClient.h"
+#include "BenchCommon.h"
+
+#include "SubFilters.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace
+{
+
+using ClientImpl = bench::ClientImpl;
+using DataBuf = bench::DataBuf;
+using OutputSink = bench::OutputSink;
+using Config = cc_mqttsn_client::Config;
+using PublishMsg = cc_mqttsn_client::PublishMsg;
+using TopicIdType = PublishMsg::Field_flags::Field_topicIdType::ValueType;
+
+const CC_MqttsnTopicId BenchTopicId = 123U;
+const char* const BenchTopic = "bench/topic/data";
+const char* const BenchFilter = "bench/+/data";
+const std::size_t Iterations = 100000U;
+const unsigned MsgIdsCount = 64U;
+
+template <typename TField>
+bool assignData(TField& field, const DataBuf& data)
+{
+    // Fixed size storage of some of the configuration variants may not fit the data
+    auto& storage = field.value();
+    if (storage.max_size() < data.size()) {
+        return false;
+    }
+
+    storage.assign(data.begin(), data.end());
+    return true;
+}
+
+const char* qosName(CC_MqttsnQoS qos)
+{
+    static const char* Names[] = {"QoS0", "QoS1", "QoS2"};
+    return Names[static_cast<unsigned>(qos)];
+}
+
+void benchProcessPublish(CC_MqttsnQoS qos, bool verifySub, std::size_t payloadLen)
+{
+    auto name = std::string("processData(PUBLISH) ") + qosName(qos) + (verifySub ? ", sub verification" : ", no sub verification");
+    if ((Config::MaxQos < static_cast<unsigned>(qos)) ||
+        (verifySub && (!Config::HasSubTopicVerification))) {
+        bench::report(name + " (not supported)", payloadLen, 0.0);
+        return;
+    }
+
+    OutputSink sink;
+    std::size_t received = 0U;
+    auto client = bench::allocConnectedClient(sink, &received);
+    if (!client) {
+        std::cerr << "ERROR: Failed to connect client" << std::endl;
+        return;
+    }
+
+    client->configState().m_verifySubFilter = verifySub;
+    client->storeInRegTopic(BenchTopic, BenchTopicId);
+    if (verifySub) {
+        client->reuseState().m_subFilters.addTopic(BenchFilter);
+    }
+
+    DataBuf data(payloadLen);
+    for (auto idx = 0U; idx < data.size(); ++idx) {
+        data[idx] = static_cast<std::uint8_t>(idx);
+    }
+
+    // Use different message IDs to avoid detection of the duplicates
+    std::vector<DataBuf> publishFrames(MsgIdsCount);
+    std::vector<DataBuf> pubrelFrames(MsgIdsCount);
+    for (auto idx = 0U; idx < MsgIdsCount; ++idx) {
+        auto msgId = static_cast<std::uint16_t>(idx + 1U);
+        PublishMsg publishMsg;
+        publishMsg.field_flags().field_qos().setValue(qos);
+        publishMsg.field_flags().field_topicIdType().value() = TopicIdType::Normal;
+        publishMsg.field_topicId().value() = BenchTopicId;
+        if (qos != CC_MqttsnQoS_AtMostOnceDelivery) {
+            publishMsg.field_msgId().value() = msgId;
+        }
+
+        if (!assignData(publishMsg.field_data(), data)) {
+            bench::report(name + " (not supported)", payloadLen, 0.0);
+            return;
+        }
+
+        if (!bench::writeFrame(publishMsg, publishFrames[idx])) {
+            std::cerr << "ERROR: Failed to serialize PUBLISH" << std::endl;
+            return;
+        }
+
+        cc_mqttsn_client::PubrelMsg pubrelMsg;
+        pubrelMsg.field_msgId().value() = msgId;
+        if (!bench::writeFrame(pubrelMsg, pubrelFrames[idx])) {
+            std::cerr << "ERROR: Failed to serialize PUBREL" << std::endl;
+            return;
+        }
+    }
+
+    bool exactlyOnce = (qos == CC_MqttsnQoS_ExactlyOnceDelivery);
+    auto nsPerIter =
+        bench::measureNsPerIter(
+            Iterations,
+            [&client, &publishFrames, &pubrelFrames, exactlyOnce](std::size_t iter)
+            {
+                auto idx = iter % MsgIdsCount;
+                auto& publishFrame = publishFrames[idx];
+                client->processData(publishFrame.data(), static_cast<unsigned>(publishFrame.size()), CC_MqttsnDataOrigin_ConnectedGw);
+                if (exactlyOnce) {
+                    auto& pubrelFrame = pubrelFrames[idx];
+                    client->processData(pubrelFrame.data(), static_cast<unsigned>(pubrelFrame.size()), CC_MqttsnDataOrigin_ConnectedGw);
+                }
+            });
+
+    if (received != Iterations) {
+        std::cerr << "ERROR: Unexpected number of reported messages: " << received << std::endl;
+    }
+
+    bench::doNotOptimize(sink.m_last);
+    bench::report(name, payloadLen, nsPerIter);
+}
+
+void benchSendMessage(std::size_t payloadLen, bool externalPayload)
+{
+    auto name = std::string("sendMessage(PUBLISH) ") + (externalPayload ? "external payload" : "payload field");
+    OutputSink sink;
+    auto client = bench::allocConnectedClient(sink);
+    if (!client) {
+        std::cerr << "ERROR: Failed to connect client" << std::endl;
+        return;
+    }
+
+    DataBuf data(payloadLen);
+    for (auto idx = 0U; idx < data.size(); ++idx) {
+        data[idx] = static_cast<std::uint8_t>(idx);
+    }
+
+    PublishMsg msg;
+    msg.field_flags().field_qos().setValue(CC_MqttsnQoS_AtMostOnceDelivery);
+    msg.field_flags().field_topicIdType().value() = TopicIdType::PredefinedTopicId;
+    msg.field_topicId().value() = BenchTopicId;
+    if ((!externalPayload) && (!assignData(msg.field_data(), data))) {
+        bench::report(name + " (not supported)", payloadLen, 0.0);
+        return;
+    }
+
+    auto send =
+        [&client, &msg, &data, externalPayload]()
+        {
+            if (externalPayload) {
+                return client->sendMessage(msg, data.data(), static_cast<unsigned>(data.size()));
+            }
+
+            return client->sendMessage(msg);
+        };
+
+    if (send() != CC_MqttsnErrorCode_Success) {
+        bench::report(name + " (not supported)", payloadLen, 0.0);
+        return;
+    }
+
+    auto nsPerIter =
+        bench::measureNsPerIter(
+            Iterations,
+            [&send](std::size_t)
+            {
+                [[maybe_unused]] auto ec = send();
+            });
+
+    bench::doNotOptimize(sink.m_last);
+    bench::report(name, payloadLen, nsPerIter);
+}
+
+void benchPublishQos0(std::size_t payloadLen)
+{
+    OutputSink sink;
+    auto client = bench::allocConnectedClient(sink);
+    if (!client) {
+        std::cerr << "ERROR: Failed to connect client" << std::endl;
+        return;
+    }
+
+    DataBuf data(payloadLen);
+    auto config = CC_MqttsnPublishConfig();
+    config.m_data = data.data();
+    config.m_dataLen = static_cast<unsigned>(data.size());
+    config.m_topicId = BenchTopicId;
+    config.m_qos = CC_MqttsnQoS_AtMostOnceDelivery;
+
+    // Whole immediate publish path without the operation allocation
+    auto nsPerIter =
+        bench::measureNsPerIter(
+            Iterations,
+            [&client, &config](std::size_t)
+            {
+                bench::doNotOptimize(client->publishQos0(&config));
+            });
+
+    bench::doNotOptimize(sink.m_last);
+    bench::report("publishQos0() predefined topic ID", payloadLen, nsPerIter);
+}
+
+enum TopicKind
+{
+    TopicKind_Predefined,
+    TopicKind_Registered,
+    TopicKind_Unregistered,
+    TopicKind_Prepared,
+    TopicKind_NumOfValues
+};
+
+void benchSendOpConfig(TopicKind kind)
+{
+    static const char* Names[] = {
+        /* TopicKind_Predefined */ "SendOp::config() predefined topic ID",
+        /* TopicKind_Registered */ "SendOp::config() registered topic",
+        /* TopicKind_Unregistered */ "SendOp::config() unregistered topic",
+        /* TopicKind_Prepared */ "SendOp::configPrepared() registered topic",
+    };
+    static_assert(std::extent<decltype(Names)>::value == TopicKind_NumOfValues);
+
+    OutputSink sink;
+    auto client = bench::allocConnectedClient(sink);
+    if (!client) {
+        std::cerr << "ERROR: Failed to connect client" << std::endl;
+        return;
+    }
+
+    DataBuf data(16U);
+    auto config = CC_MqttsnPublishConfig();
+    config.m_data = data.data();
+    config.m_dataLen = static_cast<unsigned>(data.size());
+    config.m_qos = CC_MqttsnQoS_AtMostOnceDelivery;
+    if (kind == TopicKind_Predefined) {
+        config.m_topicId = BenchTopicId;
+    }
+    else {
+        config.m_topic = BenchTopic;
+    }
+
+    if ((kind == TopicKind_Registered) || (kind == TopicKind_Prepared)) {
+        client->storeOutRegTopic(BenchTopic, BenchTopicId);
+    }
+
+    auto prepared = CC_MqttsnPreparedTopic();
+    if ((kind == TopicKind_Prepared) &&
+        (client->prepareTopic(BenchTopic, &prepared) != CC_MqttsnErrorCode_Success)) {
+        std::cerr << "ERROR: Failed to prepare topic" << std::endl;
+        return;
+    }
+
+    // The operation is cancelled after the configuration to measure just the preparation path
+    auto nsPerIter =
+        bench::measureNsPerIter(
+            Iterations,
+            [&client, &config, &prepared, kind](std::size_t)
+            {
+                auto ec = CC_MqttsnErrorCode_Success;
+                auto* publish = client->publishPrepare(&ec);
+                if (publish == nullptr) {
+                    return;
+                }
+
+                if (kind == TopicKind_Prepared) {
+                    ec = publish->configPrepared(&prepared, &config);
+                }
+                else {
+                    ec = publish->config(&config);
+                }
+
+                bench::doNotOptimize(ec);
+                publish->cancel();
+            });
+
+    bench::report(Names[kind], 0U, nsPerIter);
+}
+
+void benchSubFiltersMatch(unsigned count)
+{
+    cc_mqttsn_client::SubFilters filters;
+    std::vector<std::string> topics;
+    for (auto idx = 0U; idx < count; ++idx) {
+        auto prefix = "bench/" + std::to_string(idx);
+        filters.addTopic((prefix + "/+/data").c_str());
+        topics.push_back(prefix + "/topic/data");
+    }
+
+    if (!filters.hasTopic(("bench/" + std::to_string(count - 1U) + "/+/data").c_str())) {
+        std::cout << "Subscription filters limit reached for " << count << " filters, skipping" << std::endl;
+        return;
+    }
+
+    auto nsPerIter =
+        bench::measureNsPerIter(
+            Iterations,
+            [&filters, &topics](std::size_t iter)
+            {
+                auto& topic = topics[iter % topics.size()];
+                bench::doNotOptimize(filters.isMatch(topic));
+            });
+
+    bench::report("SubFilters::isMatch() matching", count, nsPerIter);
+
+    static const std::string NotMatchingTopic("other/topic/data");
+    nsPerIter =
+        bench::measureNsPerIter(
+            Iterations,
+            [&filters](std::size_t)
+            {
+                bench::doNotOptimize(filters.isMatch(NotMatchingTopic));
+            });
+
+    bench::report("SubFilters::isMatch() not matching", count, nsPerIter);
+}
+
+void benchIsTopicMatch()
+{
+    static const std::pair<const char*, const char*> Cases[] = {
+        {"#", "bench/topic/data"},
+        {"bench/topic/data", "bench/topic/data"},
+        {"bench/+/data", "bench/topic/data"},
+        {"bench/#", "bench/topic/data"},
+        {"+/+/+/+/+/+/+/+", "a/b/c/d/e/f/g/h"},
+        {"bench/topic/other", "bench/topic/data"},
+    };
+
+    for (auto& info : Cases) {
+        std::string_view filter(info.first);
+        std::string_view topic(info.second);
+        auto nsPerIter =
+            bench::measureNsPerIter(
+                Iterations,
+                [filter, topic](std::size_t)
+                {
+                    bench::doNotOptimize(cc_mqttsn_client::SubFilters::isTopicMatch(filter, topic));
+                });
+
+        bench::report(std::string("isTopicMatch(\"") + info.first + "\")", 1U, nsPerIter);
+    }
+}
+
+} // namespace
+
+int main()
+{
+    static const std::size_t PayloadLens[] = {0U, 16U, 128U, 1024U};
+    static const CC_MqttsnQoS Qos[] = {CC_MqttsnQoS_AtMostOnceDelivery, CC_MqttsnQoS_AtLeastOnceDelivery, CC_MqttsnQoS_ExactlyOnceDelivery};
+    for (auto qos : Qos) {
+        for (auto payloadLen : PayloadLens) {
+            benchProcessPublish(qos, false, payloadLen);
+            benchProcessPublish(qos, true, payloadLen);
+        }
+    }
+
+    for (auto payloadLen : PayloadLens) {
+        benchSendMessage(payloadLen, false);
+        benchSendMessage(payloadLen, true);
+        benchPublishQos0(payloadLen);
+    }
+
+    for (auto kind = 0U; kind < TopicKind_NumOfValues; ++kind) {
+        benchSendOpConfig(static_cast<TopicKind>(kind));
+    }
+
+    benchIsTopicMatch();
+
+    static const unsigned FilterCounts[] = {1U, 4U, 8U, 16U, 64U, 256U, 1024U};
+    for (auto count : FilterCounts) {
+        benchSubFiltersMatch(count);
+    }
+
+    return 0;
+}
@@ -0,0 +1,106 @@
+#include "BenchClient.h"
+#include "BenchCommon.h"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace
+{
+
+using ClientImpl = bench::ClientImpl;
+using DataBuf = bench::DataBuf;
+using OutputSink = bench::OutputSink;
+
+const CC_MqttsnTopicId BenchTopicId = 123U;
+const std::size_t Iterations = 100000U;
+
+void publishCompleteCb(
+    [[maybe_unused]] void* data,
+    [[maybe_unused]] CC_MqttsnPublishHandle handle,
+    [[maybe_unused]] CC_MqttsnAsyncOpStatus status,
+    [[maybe_unused]] const CC_MqttsnPublishInfo* info)
+{
+}
+
+void doSubscribeCancel(ClientImpl& client)
+{
+    auto ec = CC_MqttsnErrorCode_Success;
+    auto* subscribe = client.subscribePrepare(&ec);
+    if (subscribe != nullptr) {
+        subscribe->cancel();
+    }
+}
+
+void doPublish(ClientImpl& client, const DataBuf& data)
+{
+    auto ec = CC_MqttsnErrorCode_Success;
+    auto* publish = client.publishPrepare(&ec);
+    if (publish == nullptr) {
+        return;
+    }
+
+    auto config = CC_MqttsnPublishConfig();
+    config.m_topicId = BenchTopicId;
+    config.m_data = data.data();
+    config.m_dataLen = static_cast<unsigned>(data.size());
+    config.m_qos = CC_MqttsnQoS_AtMostOnceDelivery;
+
+    if (publish->config(&config) != CC_MqttsnErrorCode_Success) {
+        publish->cancel();
+        return;
+    }
+
+    publish->send(&publishCompleteCb, nullptr);
+}
+
+// The "noise" allocations of random sizes simulate other clients and
+// application objects sharing the same heap on the gateway.
+void benchChurn(const char* name, unsigned slabLimit, std::size_t noiseSlots)
+{
+    OutputSink sink;
+    auto client = bench::allocConnectedClient(sink);
+    if (!client) {
+        std::cerr << "ERROR: Failed to connect client" << std::endl;
+        return;
+    }
+
+    if (client->setOpsSlabLimit(slabLimit) != CC_MqttsnErrorCode_Success) {
+        bench::report(std::string(name) + " (not supported)", noiseSlots, 0.0);
+        return;
+    }
+
+    DataBuf data(32U);
+    std::vector<DataBuf> noise(noiseSlots);
+    std::uint32_t randState = 0U;
+
+    auto nsPerIter =
+        bench::measureNsPerIter(
+            Iterations,
+            [&client, &data, &noise, &randState](std::size_t)
+            {
+                doSubscribeCancel(*client);
+                doPublish(*client, data);
+
+                if (!noise.empty()) {
+                    auto& slot = noise[bench::nextRand(randState) % noise.size()];
+                    slot = DataBuf(16U + (bench::nextRand(randState) % 1024U));
+                }
+            });
+
+    bench::doNotOptimize(sink.m_last);
+    bench::report(name, noiseSlots, nsPerIter);
+}
+
+} // namespace
+
+int main()
+{
+    static const std::size_t NoiseSlots[] = {0U, 64U, 1024U};
+    for (auto slots : NoiseSlots) {
+        benchChurn("Ops churn: malloc", 0U, slots);
+        benchChurn("Ops churn: slab", 4U, slots);
+    }
+
+    return 0;
+}
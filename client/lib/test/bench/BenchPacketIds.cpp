@@ -0,0 +1,125 @@
+#include "BenchCommon.h"
+
+#include "PacketIdAllocator.h"
+
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+
+template <unsigned TLimit>
+using Allocator = cc_mqttsn_client::PacketIdAllocatorImpl<TLimit>;
+
+template <typename TAlloc>
+bool fill(TAlloc& alloc, std::vector<std::uint16_t>& ids, unsigned count)
+{
+    for (auto idx = 0U; idx < count; ++idx) {
+        auto id = alloc.alloc();
+        if (id == 0U) {
+            return false;
+        }
+
+        ids.push_back(id);
+    }
+    return true;
+}
+
+template <unsigned TLimit>
+void benchAllocReleaseRandom(const std::string& name, unsigned count)
+{
+    Allocator<TLimit> alloc;
+    std::vector<std::uint16_t> ids;
+    if (!fill(alloc, ids, count)) {
+        std::cout << "Packet IDs limit reached for " << count << " IDs, skipping" << std::endl;
+        return;
+    }
+
+    std::uint32_t randState = count;
+    static const std::size_t Iterations = 1000000U;
+    auto nsPerIter =
+        bench::measureNsPerIter(
+            Iterations,
+            [&alloc, &ids, &randState](std::size_t)
+            {
+                // Simulate acknowledgement of a random in-flight op and allocation for a new one
+                auto& id = ids[bench::nextRand(randState) % ids.size()];
+                alloc.release(id);
+                id = alloc.alloc();
+                bench::doNotOptimize(id);
+            });
+
+    bench::report(name + " release(random) + alloc()", count, nsPerIter);
+}
+
+template <unsigned TLimit>
+void benchAllocReleaseOldest(const std::string& name, unsigned count)
+{
+    Allocator<TLimit> alloc;
+    std::vector<std::uint16_t> ids;
+    if (!fill(alloc, ids, count)) {
+        return;
+    }
+
+    static const std::size_t Iterations = 1000000U;
+    auto nsPerIter =
+        bench::measureNsPerIter(
+            Iterations,
+            [&alloc, &ids](std::size_t iter)
+            {
+                // In order acknowledgement, the ring of the in-flight IDs
+                auto& id = ids[iter % ids.size()];
+                alloc.release(id);
+                id = alloc.alloc();
+                bench::doNotOptimize(id);
+            });
+
+    bench::report(name + " release(oldest) + alloc()", count, nsPerIter);
+}
+
+void benchSaturate()
+{
+    // Allocation of the whole ID space followed by its release
+    static const unsigned Rounds = 20U;
+    double total = 0.0;
+    for (auto round = 0U; round < Rounds; ++round) {
+        Allocator<0U> alloc;
+        std::vector<std::uint16_t> ids;
+        ids.reserve(0xffff);
+        total +=
+            bench::measureNsPerIter(
+                0xfffe,
+                [&alloc, &ids](std::size_t)
+                {
+                    ids.push_back(alloc.alloc());
+                });
+
+        bench::doNotOptimize(alloc.alloc()); // Must fail
+        for (auto id : ids) {
+            alloc.release(id);
+        }
+    }
+
+    bench::report("Unlimited alloc() until saturation", 0xfffe, total / Rounds);
+}
+
+} // namespace
+
+int main()
+{
+    static const unsigned Counts[] = {1U, 4U, 16U, 64U, 256U, 1024U, 4096U, 16384U, 65000U, 65534U};
+    for (auto count : Counts) {
+        benchAllocReleaseRandom<0U>("Unlimited", count);
+        benchAllocReleaseOldest<0U>("Unlimited", count);
+    }
+
+    static const unsigned BoundedCounts[] = {1U, 4U, 8U};
+    for (auto count : BoundedCounts) {
+        benchAllocReleaseRandom<8U>("Limit(8)", count);
+        benchAllocReleaseOldest<8U>("Limit(8)", count);
+    }
+
+    benchSaturate();
+    return 0;
+}
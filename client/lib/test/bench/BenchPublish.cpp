@@ -0,0 +1,134 @@
+#include "BenchClient.h"
+#include "BenchCommon.h"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace
+{
+
+using ClientImpl = bench::ClientImpl;
+using DataBuf = bench::DataBuf;
+using OutputSink = bench::OutputSink;
+
+const CC_MqttsnTopicId BenchTopicId = 123U;
+const std::size_t Iterations = 100000U;
+
+enum OutputMode
+{
+    OutputMode_Data,
+    OutputMode_Segments,
+    OutputMode_Buffer,
+};
+
+void sendOutputSegmentsCb(void* data, const CC_MqttsnOutputSegment* segments, unsigned count, [[maybe_unused]] unsigned broadcastRadius)
+{
+    for (auto idx = 0U; idx < count; ++idx) {
+        bench::sendOutputDataCb(data, segments[idx].m_data, segments[idx].m_dataLen, broadcastRadius);
+    }
+}
+
+unsigned char* getOutputBufferCb(void* data, unsigned bufLen)
+{
+    auto* sink = reinterpret_cast<OutputSink*>(data);
+    if (sink->m_buf.size() < bufLen) {
+        sink->m_buf.resize(bufLen);
+    }
+
+    return sink->m_buf.data();
+}
+
+void commitOutputBufferCb(void* data, unsigned char* buf, unsigned bufLen, [[maybe_unused]] unsigned broadcastRadius)
+{
+    auto* sink = reinterpret_cast<OutputSink*>(data);
+    if (0U < bufLen) {
+        sink->m_last ^= buf[bufLen - 1U];
+    }
+    sink->m_bytes += bufLen;
+}
+
+void publishCompleteCb(
+    [[maybe_unused]] void* data,
+    [[maybe_unused]] CC_MqttsnPublishHandle handle,
+    [[maybe_unused]] CC_MqttsnAsyncOpStatus status,
+    [[maybe_unused]] const CC_MqttsnPublishInfo* info)
+{
+}
+
+CC_MqttsnErrorCode doPublish(ClientImpl& client, const DataBuf& data, bool zeroCopy)
+{
+    auto ec = CC_MqttsnErrorCode_Success;
+    auto* publish = client.publishPrepare(&ec);
+    if (publish == nullptr) {
+        return ec;
+    }
+
+    auto config = CC_MqttsnPublishConfig();
+    config.m_topicId = BenchTopicId;
+    config.m_data = data.data();
+    config.m_dataLen = static_cast<unsigned>(data.size());
+    config.m_qos = CC_MqttsnQoS_AtMostOnceDelivery;
+
+    ec = publish->config(&config, zeroCopy);
+    if (ec != CC_MqttsnErrorCode_Success) {
+        publish->cancel();
+        return ec;
+    }
+
+    return publish->send(&publishCompleteCb, nullptr);
+}
+
+void benchPublish(const char* name, std::size_t payloadLen, bool zeroCopy, OutputMode mode)
+{
+    OutputSink sink;
+    auto client = bench::allocConnectedClient(sink);
+    if (!client) {
+        std::cerr << "ERROR: Failed to connect client" << std::endl;
+        return;
+    }
+
+    if (mode == OutputMode_Segments) {
+        client->setSendOutputSegmentsCallback(&sendOutputSegmentsCb, &sink);
+    }
+    else if (mode == OutputMode_Buffer) {
+        client->setOutputBufferCallbacks(&getOutputBufferCb, &commitOutputBufferCb, &sink);
+    }
+
+    DataBuf data(payloadLen);
+    for (auto idx = 0U; idx < data.size(); ++idx) {
+        data[idx] = static_cast<std::uint8_t>(idx);
+    }
+
+    if (doPublish(*client, data, zeroCopy) != CC_MqttsnErrorCode_Success) {
+        bench::report(std::string(name) + " (not supported)", payloadLen, 0.0);
+        return;
+    }
+
+    auto nsPerIter =
+        bench::measureNsPerIter(
+            Iterations,
+            [&client, &data, zeroCopy](std::size_t)
+            {
+                [[maybe_unused]] auto ec = doPublish(*client, data, zeroCopy);
+            });
+
+    bench::doNotOptimize(sink.m_last);
+    bench::report(name, payloadLen, nsPerIter);
+}
+
+} // namespace
+
+int main()
+{
+    static const std::size_t PayloadLens[] = {0U, 16U, 64U, 128U, 256U, 1024U, 4096U, 16384U, 60000U};
+    for (auto payloadLen : PayloadLens) {
+        benchPublish("QoS0 publish: copy", payloadLen, false, OutputMode_Data);
+        benchPublish("QoS0 publish: copy, output buffer", payloadLen, false, OutputMode_Buffer);
+        benchPublish("QoS0 publish: zero copy, single buffer", payloadLen, true, OutputMode_Data);
+        benchPublish("QoS0 publish: zero copy, segments", payloadLen, true, OutputMode_Segments);
+        benchPublish("QoS0 publish: zero copy, output buffer", payloadLen, true, OutputMode_Buffer);
+    }
+
+    return 0;
+}
@@ -0,0 +1,204 @@
+#include "BenchCommon.h"
+
+#include "TimerMgr.h"
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+namespace
+{
+
+using TimerMgr = cc_mqttsn_client::TimerMgr;
+
+class BenchOp
+{
+public:
+    explicit BenchOp(TimerMgr& timerMgr) :
+        m_timer(timerMgr.allocTimer())
+    {
+    }
+
+    bool isValid() const
+    {
+        return m_timer.isValid();
+    }
+
+    void restart(unsigned timeoutMs)
+    {
+        m_timeoutMs = timeoutMs;
+        m_timer.wait(timeoutMs, &BenchOp::timeoutCb, this);
+    }
+
+    TimerMgr::Timer& timer()
+    {
+        return m_timer;
+    }
+
+private:
+    static void timeoutCb(void* data)
+    {
+        // Simulate retransmission re-arming the timer
+        auto* op = reinterpret_cast<BenchOp*>(data);
+        op->restart(op->m_timeoutMs);
+    }
+
+    TimerMgr::Timer m_timer;
+    unsigned m_timeoutMs = 0U;
+};
+
+using BenchOpPtr = std::unique_ptr<BenchOp>;
+using BenchOpsList = std::vector<BenchOpPtr>;
+
+bool allocOps(TimerMgr& timerMgr, BenchOpsList& ops, unsigned count, std::uint32_t& randState, unsigned minTimeout = 1000U)
+{
+    for (auto idx = 0U; idx < count; ++idx) {
+        auto op = std::make_unique<BenchOp>(timerMgr);
+        if (!op->isValid()) {
+            return false;
+        }
+
+        op->restart(minTimeout + (bench::nextRand(randState) % 9000U));
+        ops.push_back(std::move(op));
+    }
+    return true;
+}
+
+void benchTickAndMinWait(unsigned count)
+{
+    TimerMgr timerMgr;
+    BenchOpsList ops;
+    std::uint32_t randState = count;
+    // Use long timeouts to measure the bookkeeping overhead rather than the expiry callbacks
+    if (!allocOps(timerMgr, ops, count, randState, 10000000U)) {
+        std::cout << "Timers limit reached for " << count << " timers, skipping" << std::endl;
+        return;
+    }
+
+    static const std::size_t Iterations = 1000000U;
+    auto nsPerIter =
+        bench::measureNsPerIter(
+            Iterations,
+            [&timerMgr](std::size_t)
+            {
+                timerMgr.tick(1U);
+                auto minWait = timerMgr.getMinWait();
+                bench::doNotOptimize(minWait);
+            });
+
+    bench::report("TimerMgr::tick(1) + getMinWait()", count, nsPerIter);
+}
+
+void benchTickWithExpiry(unsigned count)
+{
+    TimerMgr timerMgr;
+    BenchOpsList ops;
+    std::uint32_t randState = count;
+    if (!allocOps(timerMgr, ops, count, randState)) {
+        return;
+    }
+
+    static const std::size_t Iterations = 100000U;
+    auto nsPerIter =
+        bench::measureNsPerIter(
+            Iterations,
+            [&timerMgr, count](std::size_t)
+            {
+                // Advance time enough for a couple of timers to expire on average
+                timerMgr.tick(std::max(10000U / count, 1U));
+                auto minWait = timerMgr.getMinWait();
+                bench::doNotOptimize(minWait);
+            });
+
+    bench::report("TimerMgr::tick() with expiry + getMinWait()", count, nsPerIter);
+}
+
+void benchRestart(unsigned count)
+{
+    TimerMgr timerMgr;
+    BenchOpsList ops;
+    std::uint32_t randState = count;
+    if (!allocOps(timerMgr, ops, count, randState)) {
+        return;
+    }
+
+    static const std::size_t Iterations = 1000000U;
+    auto nsPerIter =
+        bench::measureNsPerIter(
+            Iterations,
+            [&ops, &timerMgr, &randState](std::size_t iter)
+            {
+                // Simulate reception of the acknowledgement and arming of the new timer
+                auto& op = ops[iter % ops.size()];
+                op->timer().cancel();
+                op->restart(1000U + (bench::nextRand(randState) % 9000U));
+                auto minWait = timerMgr.getMinWait();
+                bench::doNotOptimize(minWait);
+            });
+
+    bench::report("Timer::cancel() + Timer::wait() + getMinWait()", count, nsPerIter);
+}
+
+void benchSuspendResume(unsigned count)
+{
+    TimerMgr timerMgr;
+    BenchOpsList ops;
+    std::uint32_t randState = count;
+    if (!allocOps(timerMgr, ops, count, randState)) {
+        return;
+    }
+
+    static const std::size_t Iterations = 1000000U;
+    auto nsPerIter =
+        bench::measureNsPerIter(
+            Iterations,
+            [&ops](std::size_t iter)
+            {
+                auto& op = ops[iter % ops.size()];
+                op->timer().setSuspended(true);
+                op->timer().setSuspended(false);
+            });
+
+    bench::report("Timer::setSuspended(true/false)", count, nsPerIter);
+}
+
+void benchAllocFree(unsigned count)
+{
+    TimerMgr timerMgr;
+    BenchOpsList ops;
+    std::uint32_t randState = count;
+    if (!allocOps(timerMgr, ops, count, randState)) {
+        return;
+    }
+
+    static const std::size_t Iterations = 1000000U;
+    auto nsPerIter =
+        bench::measureNsPerIter(
+            Iterations,
+            [&ops, &timerMgr, &randState](std::size_t iter)
+            {
+                // Simulate op completion and allocation of a new op in its place
+                auto& op = ops[(bench::nextRand(randState) + iter) % ops.size()];
+                op.reset();
+                op = std::make_unique<BenchOp>(timerMgr);
+                op->restart(1000U + (bench::nextRand(randState) % 9000U));
+            });
+
+    bench::report("TimerMgr::allocTimer() + free", count, nsPerIter);
+}
+
+} // namespace
+
+int main()
+{
+    static const unsigned Counts[] = {4U, 16U, 64U, 256U, 1024U, 4096U, 16384U};
+    for (auto count : Counts) {
+        benchTickAndMinWait(count);
+        benchTickWithExpiry(count);
+        benchRestart(count);
+        benchSuspendResume(count);
+        benchAllocFree(count);
+    }
+
+    return 0;
+}
@@ -7,12 +7,21 @@ const UnitTestDefaultBase::LibFuncs& UnitTestDefaultBase::getFuncs()
     static LibFuncs funcs;
     funcs.m_alloc = &cc_mqttsn_client_alloc;
     funcs.m_free = &cc_mqttsn_client_free;
+    funcs.m_set_alloc_callbacks = &cc_mqttsn_client_set_alloc_callbacks;
+    funcs.m_set_ops_slab_limit = &cc_mqttsn_client_set_ops_slab_limit;
     funcs.m_tick = &cc_mqttsn_client_tick;
     funcs.m_process_data = &cc_mqttsn_client_process_data;
+    funcs.m_process_data_batch = &cc_mqttsn_client_process_data_batch;
+    funcs.m_rx_ring_push = &cc_mqttsn_client_rx_ring_push;
+    funcs.m_rx_ring_drain = &cc_mqttsn_client_rx_ring_drain;
     funcs.m_set_default_retry_period = &cc_mqttsn_client_set_default_retry_period;
     funcs.m_get_default_retry_period = &cc_mqttsn_client_get_default_retry_period;
     funcs.m_set_default_retry_count = &cc_mqttsn_client_set_default_retry_count;
     funcs.m_get_default_retry_count = &cc_mqttsn_client_get_default_retry_count;
+    funcs.m_set_adaptive_retry_period_enabled = &cc_mqttsn_client_set_adaptive_retry_period_enabled;
+    funcs.m_get_adaptive_retry_period_enabled = &cc_mqttsn_client_get_adaptive_retry_period_enabled;
+    funcs.m_get_rtt_estimate = &cc_mqttsn_client_get_rtt_estimate;
+    funcs.m_get_retry_period_estimate = &cc_mqttsn_client_get_retry_period_estimate;
     funcs.m_set_default_broadcast_radius = &cc_mqttsn_client_set_default_broadcast_radius;
     funcs.m_get_default_broadcast_radius = &cc_mqttsn_client_get_default_broadcast_radius;
     funcs.m_get_available_gateways_count = &cc_mqttsn_client_get_available_gateways_count;
@@ -35,6 +44,10 @@ const UnitTestDefaultBase::LibFuncs& UnitTestDefaultBase::getFuncs()
     funcs.m_get_outgoing_topic_id_storage_limit = &cc_mqttsn_client_get_outgoing_topic_id_storage_limit;
     funcs.m_set_incoming_topic_id_storage_limit = &cc_mqttsn_client_set_incoming_topic_id_storage_limit;
     funcs.m_get_incoming_topic_id_storage_limit = &cc_mqttsn_client_get_incoming_topic_id_storage_limit;
+    funcs.m_set_inflight_publishes_limit = &cc_mqttsn_client_set_inflight_publishes_limit;
+    funcs.m_get_inflight_publishes_limit = &cc_mqttsn_client_get_inflight_publishes_limit;
+    funcs.m_get_stats = &cc_mqttsn_client_get_stats;
+    funcs.m_reset_stats = &cc_mqttsn_client_reset_stats;
     funcs.m_asleep_check_messages = &cc_mqttsn_client_asleep_check_messages;
     funcs.m_search_prepare = &cc_mqttsn_client_search_prepare;
     funcs.m_search_set_retry_period = &cc_mqttsn_client_search_set_retry_period;
@@ -94,9 +107,14 @@ const UnitTestDefaultBase::LibFuncs& UnitTestDefaultBase::getFuncs()
     funcs.m_publish_get_retry_count = &cc_mqttsn_client_publish_get_retry_count;
     funcs.m_publish_init_config = &cc_mqttsn_client_publish_init_config;
     funcs.m_publish_config = &cc_mqttsn_client_publish_config;
+    funcs.m_publish_config_zero_copy = &cc_mqttsn_client_publish_config_zero_copy;
+    funcs.m_prepare_topic = &cc_mqttsn_client_prepare_topic;
+    funcs.m_publish_config_prepared = &cc_mqttsn_client_publish_config_prepared;
     funcs.m_publish_send = &cc_mqttsn_client_publish_send;
     funcs.m_publish_cancel = &cc_mqttsn_client_publish_cancel;
     funcs.m_publish = &cc_mqttsn_client_publish;
+    funcs.m_publish_qos0 = &cc_mqttsn_client_publish_qos0;
+    funcs.m_publish_batch = &cc_mqttsn_client_publish_batch;
     funcs.m_will_prepare = &cc_mqttsn_client_will_prepare;
     funcs.m_will_set_retry_period = &cc_mqttsn_client_will_set_retry_period;
     funcs.m_will_get_retry_period = &cc_mqttsn_client_will_get_retry_period;
@@ -119,7 +137,10 @@ const UnitTestDefaultBase::LibFuncs& UnitTestDefaultBase::getFuncs()
     funcs.m_sleep = &cc_mqttsn_client_sleep;
     funcs.m_set_next_tick_program_callback = &cc_mqttsn_client_set_next_tick_program_callback;
     funcs.m_set_cancel_next_tick_wait_callback = &cc_mqttsn_client_set_cancel_next_tick_wait_callback;
+    funcs.m_set_clock_callback = &cc_mqttsn_client_set_clock_callback;
     funcs.m_set_send_output_data_callback = &cc_mqttsn_client_set_send_output_data_callback;
+    funcs.m_set_send_output_segments_callback = &cc_mqttsn_client_set_send_output_segments_callback;
+    funcs.m_set_output_buffer_callbacks = &cc_mqttsn_client_set_output_buffer_callbacks;
     funcs.m_set_gw_status_report_callback = &cc_mqttsn_client_set_gw_status_report_callback;
     funcs.m_set_gw_disconnect_report_callback = &cc_mqttsn_client_set_gw_disconnect_report_callback;
     funcs.m_set_message_report_callback = &cc_mqttsn_client_set_message_report_callback;
@@ -0,0 +1,151 @@
+#include "UnitTestInPlaceBase.h"
+
+#include "in_place_client.h"
+
+const UnitTestInPlaceBase::LibFuncs& UnitTestInPlaceBase::getFuncs()
+{
+    static LibFuncs funcs;
+    funcs.m_alloc = &cc_mqttsn_in_place_client_alloc;
+    funcs.m_free = &cc_mqttsn_in_place_client_free;
+    funcs.m_set_alloc_callbacks = &cc_mqttsn_in_place_client_set_alloc_callbacks;
+    funcs.m_set_ops_slab_limit = &cc_mqttsn_in_place_client_set_ops_slab_limit;
+    funcs.m_tick = &cc_mqttsn_in_place_client_tick;
+    funcs.m_process_data = &cc_mqttsn_in_place_client_process_data;
+    funcs.m_process_data_batch = &cc_mqttsn_in_place_client_process_data_batch;
+    funcs.m_rx_ring_push = &cc_mqttsn_in_place_client_rx_ring_push;
+    funcs.m_rx_ring_drain = &cc_mqttsn_in_place_client_rx_ring_drain;
+    funcs.m_set_default_retry_period = &cc_mqttsn_in_place_client_set_default_retry_period;
+    funcs.m_get_default_retry_period = &cc_mqttsn_in_place_client_get_default_retry_period;
+    funcs.m_set_default_retry_count = &cc_mqttsn_in_place_client_set_default_retry_count;
+    funcs.m_get_default_retry_count = &cc_mqttsn_in_place_client_get_default_retry_count;
+    funcs.m_set_adaptive_retry_period_enabled = &cc_mqttsn_in_place_client_set_adaptive_retry_period_enabled;
+    funcs.m_get_adaptive_retry_period_enabled = &cc_mqttsn_in_place_client_get_adaptive_retry_period_enabled;
+    funcs.m_get_rtt_estimate = &cc_mqttsn_in_place_client_get_rtt_estimate;
+    funcs.m_get_retry_period_estimate = &cc_mqttsn_in_place_client_get_retry_period_estimate;
+    funcs.m_set_default_broadcast_radius = &cc_mqttsn_in_place_client_set_default_broadcast_radius;
+    funcs.m_get_default_broadcast_radius = &cc_mqttsn_in_place_client_get_default_broadcast_radius;
+    funcs.m_get_available_gateways_count = &cc_mqttsn_in_place_client_get_available_gateways_count;
+    funcs.m_init_gateway_info = &cc_mqttsn_in_place_client_init_gateway_info;
+    funcs.m_get_available_gateway_info = &cc_mqttsn_in_place_client_get_available_gateway_info;
+    funcs.m_set_available_gateway_info = &cc_mqttsn_in_place_client_set_available_gateway_info;
+    funcs.m_discard_available_gateway_info = &cc_mqttsn_in_place_client_discard_available_gateway_info;
+    funcs.m_discard_all_gateway_infos = &cc_mqttsn_in_place_client_discard_all_gateway_infos;
+    funcs.m_set_default_gw_adv_duration = &cc_mqttsn_in_place_client_set_default_gw_adv_duration;
+    funcs.m_get_default_gw_adv_duration = &cc_mqttsn_in_place_client_get_default_gw_adv_duration;
+    funcs.m_set_allowed_adv_losses = &cc_mqttsn_in_place_client_set_allowed_adv_losses;
+    funcs.m_get_allowed_adv_losses = &cc_mqttsn_in_place_client_get_allowed_adv_losses;
+    funcs.m_set_verify_outgoing_topic_enabled = &cc_mqttsn_in_place_client_set_verify_outgoing_topic_enabled;
+    funcs.m_get_verify_outgoing_topic_enabled = &cc_mqttsn_in_place_client_get_verify_outgoing_topic_enabled;
+    funcs.m_set_verify_incoming_topic_enabled = &cc_mqttsn_in_place_client_set_verify_incoming_topic_enabled;
+    funcs.m_get_verify_incoming_topic_enabled = &cc_mqttsn_in_place_client_get_verify_incoming_topic_enabled;
+    funcs.m_set_verify_incoming_msg_subscribed = &cc_mqttsn_in_place_client_set_verify_incoming_msg_subscribed;
+    funcs.m_get_verify_incoming_msg_subscribed = &cc_mqttsn_in_place_client_get_verify_incoming_msg_subscribed;
+    funcs.m_set_outgoing_topic_id_storage_limit = &cc_mqttsn_in_place_client_set_outgoing_topic_id_storage_limit;
+    funcs.m_get_outgoing_topic_id_storage_limit = &cc_mqttsn_in_place_client_get_outgoing_topic_id_storage_limit;
+    funcs.m_set_incoming_topic_id_storage_limit = &cc_mqttsn_in_place_client_set_incoming_topic_id_storage_limit;
+    funcs.m_get_incoming_topic_id_storage_limit = &cc_mqttsn_in_place_client_get_incoming_topic_id_storage_limit;
+    funcs.m_set_inflight_publishes_limit = &cc_mqttsn_in_place_client_set_inflight_publishes_limit;
+    funcs.m_get_inflight_publishes_limit = &cc_mqttsn_in_place_client_get_inflight_publishes_limit;
+    funcs.m_get_stats = &cc_mqttsn_in_place_client_get_stats;
+    funcs.m_reset_stats = &cc_mqttsn_in_place_client_reset_stats;
+    funcs.m_asleep_check_messages = &cc_mqttsn_in_place_client_asleep_check_messages;
+    funcs.m_search_prepare = &cc_mqttsn_in_place_client_search_prepare;
+    funcs.m_search_set_retry_period = &cc_mqttsn_in_place_client_search_set_retry_period;
+    funcs.m_search_get_retry_period = &cc_mqttsn_in_place_client_search_get_retry_period;
+    funcs.m_search_set_retry_count = &cc_mqttsn_in_place_client_search_set_retry_count;
+    funcs.m_search_get_retry_count = &cc_mqttsn_in_place_client_search_get_retry_count;
+    funcs.m_search_set_broadcast_radius = &cc_mqttsn_in_place_client_search_set_broadcast_radius;
+    funcs.m_search_get_broadcast_radius = &cc_mqttsn_in_place_client_search_get_broadcast_radius;
+    funcs.m_search_send = &cc_mqttsn_in_place_client_search_send;
+    funcs.m_search_cancel = &cc_mqttsn_in_place_client_search_cancel;
+    funcs.m_search = &cc_mqttsn_in_place_client_search;
+    funcs.m_connect_prepare = &cc_mqttsn_in_place_client_connect_prepare;
+    funcs.m_connect_set_retry_period = &cc_mqttsn_in_place_client_connect_set_retry_period;
+    funcs.m_connect_get_retry_period = &cc_mqttsn_in_place_client_connect_get_retry_period;
+    funcs.m_connect_set_retry_count = &cc_mqttsn_in_place_client_connect_set_retry_count;
+    funcs.m_connect_get_retry_count = &cc_mqttsn_in_place_client_connect_get_retry_count;
+    funcs.m_connect_init_config = &cc_mqttsn_in_place_client_connect_init_config;
+    funcs.m_connect_config = &cc_mqttsn_in_place_client_connect_config;
+    funcs.m_connect_init_config_will = &cc_mqttsn_in_place_client_connect_init_config_will;
+    funcs.m_connect_config_will = &cc_mqttsn_in_place_client_connect_config_will;
+    funcs.m_connect_send = &cc_mqttsn_in_place_client_connect_send;
+    funcs.m_connect_cancel = &cc_mqttsn_in_place_client_connect_cancel;
+    funcs.m_connect = &cc_mqttsn_in_place_client_connect;
+    funcs.m_get_connection_status = &cc_mqttsn_in_place_client_get_connection_status;
+    funcs.m_disconnect_prepare = &cc_mqttsn_in_place_client_disconnect_prepare;
+    funcs.m_disconnect_set_retry_period = &cc_mqttsn_in_place_client_disconnect_set_retry_period;
+    funcs.m_disconnect_get_retry_period = &cc_mqttsn_in_place_client_disconnect_get_retry_period;
+    funcs.m_disconnect_set_retry_count = &cc_mqttsn_in_place_client_disconnect_set_retry_count;
+    funcs.m_disconnect_get_retry_count = &cc_mqttsn_in_place_client_disconnect_get_retry_count;
+    funcs.m_disconnect_send = &cc_mqttsn_in_place_client_disconnect_send;
+    funcs.m_disconnect_cancel = &cc_mqttsn_in_place_client_disconnect_cancel;
+    funcs.m_disconnect = &cc_mqttsn_in_place_client_disconnect;
+    funcs.m_subscribe_prepare = &cc_mqttsn_in_place_client_subscribe_prepare;
+    funcs.m_subscribe_set_retry_period = &cc_mqttsn_in_place_client_subscribe_set_retry_period;
+    funcs.m_subscribe_get_retry_period = &cc_mqttsn_in_place_client_subscribe_get_retry_period;
+    funcs.m_subscribe_set_retry_count = &cc_mqttsn_in_place_client_subscribe_set_retry_count;
+    funcs.m_subscribe_get_retry_count = &cc_mqttsn_in_place_client_subscribe_get_retry_count;
+    funcs.m_subscribe_init_config = &cc_mqttsn_in_place_client_subscribe_init_config;
+    funcs.m_subscribe_config = &cc_mqttsn_in_place_client_subscribe_config;
+    funcs.m_subscribe_send = &cc_mqttsn_in_place_client_subscribe_send;
+    funcs.m_subscribe_cancel = &cc_mqttsn_in_place_client_subscribe_cancel;
+    funcs.m_subscribe = &cc_mqttsn_in_place_client_subscribe;
+    funcs.m_unsubscribe_prepare = &cc_mqttsn_in_place_client_unsubscribe_prepare;
+    funcs.m_unsubscribe_set_retry_period = &cc_mqttsn_in_place_client_unsubscribe_set_retry_period;
+    funcs.m_unsubscribe_get_retry_period = &cc_mqttsn_in_place_client_unsubscribe_get_retry_period;
+    funcs.m_unsubscribe_set_retry_count = &cc_mqttsn_in_place_client_unsubscribe_set_retry_count;
+    funcs.m_unsubscribe_get_retry_count = &cc_mqttsn_in_place_client_unsubscribe_get_retry_count;
+    funcs.m_unsubscribe_init_config = &cc_mqttsn_in_place_client_unsubscribe_init_config;
+    funcs.m_unsubscribe_config = &cc_mqttsn_in_place_client_unsubscribe_config;
+    funcs.m_unsubscribe_send = &cc_mqttsn_in_place_client_unsubscribe_send;
+    funcs.m_unsubscribe_cancel = &cc_mqttsn_in_place_client_unsubscribe_cancel;
+    funcs.m_unsubscribe = &cc_mqttsn_in_place_client_unsubscribe;
+    funcs.m_publish_prepare = &cc_mqttsn_in_place_client_publish_prepare;
+    funcs.m_publish_set_retry_period = &cc_mqttsn_in_place_client_publish_set_retry_period;
+    funcs.m_publish_get_retry_period = &cc_mqttsn_in_place_client_publish_get_retry_period;
+    funcs.m_publish_set_retry_count = &cc_mqttsn_in_place_client_publish_set_retry_count;
+    funcs.m_publish_get_retry_count = &cc_mqttsn_in_place_client_publish_get_retry_count;
+    funcs.m_publish_init_config = &cc_mqttsn_in_place_client_publish_init_config;
+    funcs.m_publish_config = &cc_mqttsn_in_place_client_publish_config;
+    funcs.m_publish_config_zero_copy = &cc_mqttsn_in_place_client_publish_config_zero_copy;
+    funcs.m_prepare_topic = &cc_mqttsn_in_place_client_prepare_topic;
+    funcs.m_publish_config_prepared = &cc_mqttsn_in_place_client_publish_config_prepared;
+    funcs.m_publish_send = &cc_mqttsn_in_place_client_publish_send;
+    funcs.m_publish_cancel = &cc_mqttsn_in_place_client_publish_cancel;
+    funcs.m_publish = &cc_mqttsn_in_place_client_publish;
+    funcs.m_publish_qos0 = &cc_mqttsn_in_place_client_publish_qos0;
+    funcs.m_publish_batch = &cc_mqttsn_in_place_client_publish_batch;
+    funcs.m_will_prepare = &cc_mqttsn_in_place_client_will_prepare;
+    funcs.m_will_set_retry_period = &cc_mqttsn_in_place_client_will_set_retry_period;
+    funcs.m_will_get_retry_period = &cc_mqttsn_in_place_client_will_get_retry_period;
+    funcs.m_will_set_retry_count = &cc_mqttsn_in_place_client_will_set_retry_count;
+    funcs.m_will_get_retry_count = &cc_mqttsn_in_place_client_will_get_retry_count;
+    funcs.m_will_init_config = &cc_mqttsn_in_place_client_will_init_config;
+    funcs.m_will_config = &cc_mqttsn_in_place_client_will_config;
+    funcs.m_will_send = &cc_mqttsn_in_place_client_will_send;
+    funcs.m_will_cancel = &cc_mqttsn_in_place_client_will_cancel;
+    funcs.m_will = &cc_mqttsn_in_place_client_will;
+    funcs.m_sleep_prepare = &cc_mqttsn_in_place_client_sleep_prepare;
+    funcs.m_sleep_set_retry_period = &cc_mqttsn_in_place_client_sleep_set_retry_period;
+    funcs.m_sleep_get_retry_period = &cc_mqttsn_in_place_client_sleep_get_retry_period;
+    funcs.m_sleep_set_retry_count = &cc_mqttsn_in_place_client_sleep_set_retry_count;
+    funcs.m_sleep_get_retry_count = &cc_mqttsn_in_place_client_sleep_get_retry_count;
+    funcs.m_sleep_init_config = &cc_mqttsn_in_place_client_sleep_init_config;
+    funcs.m_sleep_config = &cc_mqttsn_in_place_client_sleep_config;
+    funcs.m_sleep_send = &cc_mqttsn_in_place_client_sleep_send;
+    funcs.m_sleep_cancel = &cc_mqttsn_in_place_client_sleep_cancel;
+    funcs.m_sleep = &cc_mqttsn_in_place_client_sleep;
+    funcs.m_set_next_tick_program_callback = &cc_mqttsn_in_place_client_set_next_tick_program_callback;
+    funcs.m_set_cancel_next_tick_wait_callback = &cc_mqttsn_in_place_client_set_cancel_next_tick_wait_callback;
+    funcs.m_set_clock_callback = &cc_mqttsn_in_place_client_set_clock_callback;
+    funcs.m_set_send_output_data_callback = &cc_mqttsn_in_place_client_set_send_output_data_callback;
+    funcs.m_set_send_output_segments_callback = &cc_mqttsn_in_place_client_set_send_output_segments_callback;
+    funcs.m_set_output_buffer_callbacks = &cc_mqttsn_in_place_client_set_output_buffer_callbacks;
+    funcs.m_set_gw_status_report_callback = &cc_mqttsn_in_place_client_set_gw_status_report_callback;
+    funcs.m_set_gw_disconnect_report_callback = &cc_mqttsn_in_place_client_set_gw_disconnect_report_callback;
+    funcs.m_set_message_report_callback = &cc_mqttsn_in_place_client_set_message_report_callback;
+    funcs.m_set_error_log_callback = &cc_mqttsn_in_place_client_set_error_log_callback;
+    funcs.m_set_gwinfo_delay_request_callback = &cc_mqttsn_in_place_client_set_gwinfo_delay_request_callback;
+
+    return funcs;
+}
@@ -0,0 +1,16 @@
+#pragma once
+
+#include "UnitTestCommonBase.h"
+
+class UnitTestInPlaceBase : public UnitTestCommonBase
+{
+    using Base = UnitTestCommonBase;
+protected:
+
+    UnitTestInPlaceBase():
+        Base(getFuncs())
+    {
+    }
+
+    static const LibFuncs& getFuncs();
+};
\ No newline at end of file
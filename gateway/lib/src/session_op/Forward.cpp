@@ -30,6 +30,23 @@ Forward::Forward(SessionImpl& session) :
 
 Forward::~Forward() = default;
 
+void Forward::brokerConnectionUpdatedImpl()
+{
+    if (!state().m_brokerConnected) {
+        // The broker won't acknowledge the publishes of the previous connection
+        m_pubsInProgress.clear();
+    }
+}
+
+void Forward::connStatusUpdatedImpl()
+{
+    // Disconnection or new connection of the client, the
+    // publishes of the previous one are not relevant any more.
+    if (state().m_connStatus != ConnectionStatus::Asleep) {
+        m_pubsInProgress.clear();
+    }
+}
+
 void Forward::handle(PublishMsg_SN& msg)
 {
     auto& st = state();
@@ -85,6 +102,25 @@ void Forward::handle(PublishMsg_SN& msg)
     bool dup = msg.field_flags().field_high().getBitValue_Dup();
     m_lastPubTopicId = msg.field_topicId().value();
 
+    if (msg.field_flags().field_qos().value() == cc_mqttsn::field::QosVal::AtLeastOnceDelivery) {
+        // The client may have multiple publishes in flight, remember the topic ID to report in PUBACK
+        auto msgId = msg.field_msgId().value();
+        auto iter =
+            std::find_if(
+                m_pubsInProgress.begin(), m_pubsInProgress.end(),
+                [msgId](PubsInProgressList::const_reference elem) -> bool
+                {
+                    return elem.m_msgId == msgId;
+                });
+
+        if (iter == m_pubsInProgress.end()) {
+            iter = m_pubsInProgress.insert(m_pubsInProgress.end(), PubInfo());
+            iter->m_msgId = msgId;
+        }
+
+        iter->m_topicId = m_lastPubTopicId;
+    }
+
     PublishMsg fwdMsg;
     auto& fwdFlags = fwdMsg.transportField_flags();
 
@@ -309,9 +345,24 @@ void Forward::handle(ConnackMsg&)
 
 void Forward::handle(PubackMsg& msg)
 {
+    auto msgId = msg.field_packetId().value();
+    auto topicId = m_lastPubTopicId;
+    auto iter =
+        std::find_if(
+            m_pubsInProgress.begin(), m_pubsInProgress.end(),
+            [msgId](PubsInProgressList::const_reference elem) -> bool
+            {
+                return elem.m_msgId == msgId;
+            });
+
+    if (iter != m_pubsInProgress.end()) {
+        topicId = iter->m_topicId;
+        m_pubsInProgress.erase(iter);
+    }
+
     sendPubackToClient(
-        m_lastPubTopicId,
-        msg.field_packetId().value(),
+        topicId,
+        msgId,
         ReturnCodeVal::Accepted);
 }
 
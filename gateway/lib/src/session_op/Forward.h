@@ -32,6 +32,9 @@ public:
 protected:
 
 private:
+    virtual void brokerConnectionUpdatedImpl() override;
+    virtual void connStatusUpdatedImpl() override;
+
     using Base::handle;
     virtual void handle(PublishMsg_SN& msg) override;
     virtual void handle(PubrelMsg_SN& msg) override;
@@ -64,6 +67,14 @@ private:
 
     typedef std::list<NoGwPubInfo> NoGwPubInfosList;
 
+    struct PubInfo
+    {
+        std::uint16_t m_msgId = 0;
+        std::uint16_t m_topicId = 0;
+    };
+
+    typedef std::list<PubInfo> PubsInProgressList;
+
     using ReturnCodeVal = cc_mqttsn::field::ReturnCodeVal;
     using TopicIdTypeVal = cc_mqttsn::field::TopicIdTypeVal;
     void sendPubackToClient(
@@ -73,6 +84,7 @@ private:
 
     SubsInProgressList m_subs;
     NoGwPubInfosList m_pubs;
+    PubsInProgressList m_pubsInProgress;
     std::uint16_t m_lastPubTopicId = 0;
     bool m_pingInProgress = false;
 };
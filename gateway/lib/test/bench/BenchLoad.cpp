@@ -0,0 +1,905 @@
+//
+// Copyright 2024 - 2026 (C). Alex Robenko. All rights reserved.
+//
+// SPDX-License-Identifier: MPL-2.0
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+// In-process load benchmark of the whole stack: every MQTT-SN client library
+// instance is connected to its own gateway session, which is in turn connected
+// to the minimal MQTT v3.1.1 broker stand-in reflecting the publishes back
+// to the sender. There are no sockets, the links are simulated by the
+// delivery queue driven by the virtual clock.
+//
+// Usage: cc.mqttsn.gateway.BenchLoad [clients] [messages] [qos] [payload] [window]
+//     clients - Number of the client instances, defaults to 2000.
+//     messages - Number of the messages published by every client, defaults to 10.
+//     qos - QoS of the publishes and subscriptions, defaults to 1.
+//     payload - Length of the published payload, defaults to 32.
+//     window - Max number of the in-flight publishes per client, defaults to 1.
+
+#include "cc_mqttsn_gateway/Session.h"
+#include "client.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+namespace
+{
+
+using WallClock = std::chrono::steady_clock;
+using DataBuf = std::vector<std::uint8_t>;
+using Session = cc_mqttsn_gateway::Session;
+using LatenciesList = std::vector<double>;
+
+const std::uint64_t LinkDelayMs = 1U; // One way delay of every simulated link
+const std::uint64_t PhaseTimeLimitMs = 10U * 60U * 1000U; // Virtual time limit of every phase
+const unsigned KeepAliveSec = 60U;
+const std::size_t PayloadHeaderLen = 8U; // Client index + message sequence number
+
+struct Params
+{
+    unsigned m_clients = 2000U;
+    unsigned m_messages = 10U;
+    CC_MqttsnQoS m_qos = CC_MqttsnQoS_AtLeastOnceDelivery;
+    unsigned m_payloadLen = 32U;
+    unsigned m_window = 1U;
+};
+
+enum EventType : std::uint8_t
+{
+    EventType_ToClient,
+    EventType_ToSessionFromClient,
+    EventType_ToSessionFromBroker,
+    EventType_ToBroker,
+    EventType_ClientTimer,
+    EventType_SessionTimer,
+};
+
+struct Event
+{
+    std::uint64_t m_time = 0U;
+    std::uint64_t m_seq = 0U;
+    unsigned m_node = 0U;
+    unsigned m_timerGen = 0U;
+    EventType m_type = EventType_ToClient;
+    DataBuf m_data;
+};
+
+struct EventLater
+{
+    bool operator()(const Event& e1, const Event& e2) const
+    {
+        if (e1.m_time != e2.m_time) {
+            return e2.m_time < e1.m_time;
+        }
+
+        return e2.m_seq < e1.m_seq;
+    }
+};
+
+void writeUint32(std::uint8_t* buf, std::uint32_t value)
+{
+    for (auto idx = 0U; idx < sizeof(value); ++idx) {
+        buf[idx] = static_cast<std::uint8_t>(value >> ((sizeof(value) - idx - 1U) * 8U));
+    }
+}
+
+std::uint32_t readUint32(const std::uint8_t* buf)
+{
+    std::uint32_t value = 0U;
+    for (auto idx = 0U; idx < sizeof(value); ++idx) {
+        value = (value << 8U) | buf[idx];
+    }
+    return value;
+}
+
+std::uint16_t readUint16(const std::uint8_t* buf)
+{
+    return static_cast<std::uint16_t>((static_cast<unsigned>(buf[0]) << 8U) | buf[1]);
+}
+
+void appendUint16(DataBuf& buf, std::uint16_t value)
+{
+    buf.push_back(static_cast<std::uint8_t>(value >> 8U));
+    buf.push_back(static_cast<std::uint8_t>(value));
+}
+
+void appendRemLength(DataBuf& buf, std::size_t len)
+{
+    do {
+        auto byte = static_cast<std::uint8_t>(len & 0x7fU);
+        len >>= 7U;
+        if (len != 0U) {
+            byte = static_cast<std::uint8_t>(byte | 0x80U);
+        }
+        buf.push_back(byte);
+    } while (len != 0U);
+}
+
+double percentile(LatenciesList& latencies, unsigned pct)
+{
+    if (latencies.empty()) {
+        return 0.0;
+    }
+
+    auto idx = std::min(latencies.size() - 1U, (latencies.size() * pct) / 100U);
+    std::nth_element(latencies.begin(), latencies.begin() + static_cast<std::ptrdiff_t>(idx), latencies.end());
+    return latencies[idx];
+}
+
+long peakRssKb()
+{
+#if defined(__unix__) || defined(__APPLE__)
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0;
+    }
+
+#if defined(__APPLE__)
+    return usage.ru_maxrss / 1024; // Reported in bytes
+#else
+    return usage.ru_maxrss;
+#endif
+#else
+    return 0;
+#endif
+}
+
+class LoadBench
+{
+public:
+    explicit LoadBench(const Params& params) :
+        m_params(params),
+        m_nodes(params.m_clients)
+    {
+    }
+
+    ~LoadBench()
+    {
+        for (auto& node : m_nodes) {
+            if (node.m_client != nullptr) {
+                cc_mqttsn_client_free(node.m_client);
+            }
+        }
+    }
+
+    bool run()
+    {
+        printHeader();
+        auto rssBefore = peakRssKb();
+        if (!setup()) {
+            return false;
+        }
+
+        std::cout << "Peak RSS after creation of " << m_nodes.size() << " clients: " <<
+            peakRssKb() << " KB (" << std::fixed << std::setprecision(2) <<
+            (static_cast<double>(peakRssKb() - rssBefore) / static_cast<double>(m_nodes.size())) <<
+            " KB per client + session)" << std::endl;
+
+        bool result =
+            runConnect() &&
+            runSubscribe() &&
+            runPublish();
+
+        std::cout << "Events: " << m_eventsCount << ", failures: " << m_failures <<
+            ", peak RSS: " << peakRssKb() << " KB" << std::endl;
+        return result && (m_failures == 0U);
+    }
+
+private:
+    struct Node
+    {
+        LoadBench* m_bench = nullptr;
+        unsigned m_idx = 0U;
+        CC_MqttsnClientHandle m_client = nullptr;
+        std::unique_ptr<Session> m_session;
+        std::string m_clientId;
+        std::string m_topic;
+        std::vector<std::pair<std::string, std::uint8_t> > m_brokerSubs;
+        std::vector<WallClock::time_point> m_pubTimestamps;
+        WallClock::time_point m_opTimestamp;
+        std::uint64_t m_sessionTimerStart = 0U;
+        unsigned m_clientTimerGen = 0U;
+        unsigned m_sessionTimerGen = 0U;
+        unsigned m_nextPub = 0U;
+        unsigned m_inFlight = 0U;
+        std::uint16_t m_brokerPacketId = 0U;
+        bool m_ready = false;
+    };
+
+    using NodesList = std::vector<Node>;
+    using EventsList = std::vector<Event>;
+    using ReadyList = std::vector<unsigned>;
+
+    static unsigned long long clockCb(void* data)
+    {
+        auto* node = reinterpret_cast<Node*>(data);
+        return node->m_bench->m_now;
+    }
+
+    static void clientTickProgramCb(void* data, unsigned duration)
+    {
+        auto* node = reinterpret_cast<Node*>(data);
+        ++node->m_clientTimerGen;
+        node->m_bench->pushTimer(EventType_ClientTimer, node->m_idx, node->m_clientTimerGen, duration);
+    }
+
+    static void clientSendCb(void* data, const unsigned char* buf, unsigned bufLen, [[maybe_unused]] unsigned broadcastRadius)
+    {
+        auto* node = reinterpret_cast<Node*>(data);
+        node->m_bench->pushData(EventType_ToSessionFromClient, node->m_idx, buf, bufLen);
+    }
+
+    static void gwDisconnectedCb(void* data, [[maybe_unused]] CC_MqttsnGatewayDisconnectReason reason)
+    {
+        auto* node = reinterpret_cast<Node*>(data);
+        node->m_bench->reportFailure(node->m_idx, "Gateway disconnected");
+    }
+
+    static void messageReceivedCb(void* data, const CC_MqttsnMessageInfo* info)
+    {
+        auto* node = reinterpret_cast<Node*>(data);
+        node->m_bench->messageReceived(*node, *info);
+    }
+
+    static void connectCompleteCb(void* data, CC_MqttsnAsyncOpStatus status, const CC_MqttsnConnectInfo* info)
+    {
+        auto* node = reinterpret_cast<Node*>(data);
+        bool success =
+            (status == CC_MqttsnAsyncOpStatus_Complete) &&
+            (info != nullptr) &&
+            (info->m_returnCode == CC_MqttsnReturnCode_Accepted);
+        node->m_bench->opComplete(*node, success, "Connect failed");
+    }
+
+    static void subscribeCompleteCb(
+        void* data,
+        [[maybe_unused]] CC_MqttsnSubscribeHandle handle,
+        CC_MqttsnAsyncOpStatus status,
+        const CC_MqttsnSubscribeInfo* info)
+    {
+        auto* node = reinterpret_cast<Node*>(data);
+        bool success =
+            (status == CC_MqttsnAsyncOpStatus_Complete) &&
+            (info != nullptr) &&
+            (info->m_returnCode == CC_MqttsnReturnCode_Accepted);
+        node->m_bench->opComplete(*node, success, "Subscribe failed");
+    }
+
+    static void publishCompleteCb(
+        void* data,
+        [[maybe_unused]] CC_MqttsnPublishHandle handle,
+        CC_MqttsnAsyncOpStatus status,
+        [[maybe_unused]] const CC_MqttsnPublishInfo* info)
+    {
+        auto* node = reinterpret_cast<Node*>(data);
+        node->m_bench->publishComplete(*node, status == CC_MqttsnAsyncOpStatus_Complete);
+    }
+
+    void printHeader() const
+    {
+        std::cout << "Clients: " << m_params.m_clients <<
+            ", messages per client: " << m_params.m_messages <<
+            ", QoS: " << static_cast<unsigned>(m_params.m_qos) <<
+            ", payload: " << m_params.m_payloadLen <<
+            ", window: " << m_params.m_window <<
+            ", link delay: " << LinkDelayMs << " ms" << std::endl;
+    }
+
+    bool setup()
+    {
+        for (auto idx = 0U; idx < m_nodes.size(); ++idx) {
+            auto& node = m_nodes[idx];
+            node.m_bench = this;
+            node.m_idx = idx;
+            node.m_clientId = "bench" + std::to_string(idx);
+            node.m_topic = "bench/" + std::to_string(idx);
+            node.m_pubTimestamps.resize(m_params.m_messages);
+
+            node.m_client = cc_mqttsn_client_alloc();
+            if (node.m_client == nullptr) {
+                std::cerr << "ERROR: Failed to allocate client " << idx << std::endl;
+                return false;
+            }
+
+            cc_mqttsn_client_set_clock_callback(node.m_client, &LoadBench::clockCb, &node);
+            cc_mqttsn_client_set_next_tick_program_callback(node.m_client, &LoadBench::clientTickProgramCb, &node);
+            cc_mqttsn_client_set_send_output_data_callback(node.m_client, &LoadBench::clientSendCb, &node);
+            cc_mqttsn_client_set_gw_disconnect_report_callback(node.m_client, &LoadBench::gwDisconnectedCb, &node);
+            cc_mqttsn_client_set_message_report_callback(node.m_client, &LoadBench::messageReceivedCb, &node);
+
+            node.m_session = std::make_unique<Session>();
+            auto& session = *node.m_session;
+            session.setNextTickProgramReqCb(
+                [this, &node](unsigned value)
+                {
+                    ++node.m_sessionTimerGen;
+                    node.m_sessionTimerStart = m_now;
+                    pushTimer(EventType_SessionTimer, node.m_idx, node.m_sessionTimerGen, value);
+                });
+
+            session.setCancelTickWaitReqCb(
+                [this, &node]() -> unsigned
+                {
+                    ++node.m_sessionTimerGen;
+                    return static_cast<unsigned>(m_now - node.m_sessionTimerStart);
+                });
+
+            session.setSendDataClientReqCb(
+                [this, &node](const std::uint8_t* buf, std::size_t bufSize, [[maybe_unused]] unsigned broadcastRadius)
+                {
+                    pushData(EventType_ToClient, node.m_idx, buf, bufSize);
+                });
+
+            session.setSendDataBrokerReqCb(
+                [this, &node](const std::uint8_t* buf, std::size_t bufSize)
+                {
+                    pushData(EventType_ToBroker, node.m_idx, buf, bufSize);
+                });
+
+            session.setTerminationReqCb(
+                [this, &node]()
+                {
+                    reportFailure(node.m_idx, "Session termination requested");
+                });
+
+            session.setBrokerReconnectReqCb(
+                [this, &node]()
+                {
+                    reportFailure(node.m_idx, "Broker reconnection requested");
+                });
+
+            session.setBrokerConnected(true);
+            if (!session.start()) {
+                std::cerr << "ERROR: Failed to start session " << idx << std::endl;
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    bool runConnect()
+    {
+        return runPhase(
+            "connect",
+            [this](Node& node)
+            {
+                CC_MqttsnConnectConfig config;
+                cc_mqttsn_client_connect_init_config(&config);
+                config.m_clientId = node.m_clientId.c_str();
+                config.m_duration = KeepAliveSec;
+                config.m_cleanSession = true;
+                return cc_mqttsn_client_connect(node.m_client, &config, nullptr, &LoadBench::connectCompleteCb, &node);
+            });
+    }
+
+    bool runSubscribe()
+    {
+        return runPhase(
+            "subscribe",
+            [this](Node& node)
+            {
+                CC_MqttsnSubscribeConfig config;
+                cc_mqttsn_client_subscribe_init_config(&config);
+                config.m_topic = node.m_topic.c_str();
+                config.m_qos = m_params.m_qos;
+                return cc_mqttsn_client_subscribe(node.m_client, &config, &LoadBench::subscribeCompleteCb, &node);
+            });
+    }
+
+    template <typename TStartFunc>
+    bool runPhase(const char* name, TStartFunc&& startFunc)
+    {
+        m_latencies.clear();
+        m_pending = static_cast<unsigned>(m_nodes.size());
+        auto wallStart = WallClock::now();
+        auto virtStart = m_now;
+        for (auto& node : m_nodes) {
+            node.m_opTimestamp = WallClock::now();
+            auto ec = startFunc(node);
+            if (ec != CC_MqttsnErrorCode_Success) {
+                reportFailure(node.m_idx, "Failed to initiate operation");
+                return false;
+            }
+        }
+
+        bool completed =
+            runUntil(
+                [this]()
+                {
+                    return m_pending == 0U;
+                });
+
+        report(name, m_nodes.size() - m_pending, wallStart, virtStart);
+        return completed;
+    }
+
+    bool runPublish()
+    {
+        m_latencies.clear();
+        m_latencies.reserve(static_cast<std::size_t>(m_nodes.size()) * m_params.m_messages);
+        m_payload.assign(std::max<std::size_t>(m_params.m_payloadLen, PayloadHeaderLen), 0x5a);
+        m_received = 0U;
+        m_pending = static_cast<unsigned>(m_nodes.size()) * m_params.m_messages;
+
+        auto wallStart = WallClock::now();
+        auto virtStart = m_now;
+        for (auto& node : m_nodes) {
+            publishNext(node);
+        }
+
+        bool completed =
+            runUntil(
+                [this]()
+                {
+                    return m_received == m_pending;
+                });
+
+        report("publish (reflected)", m_received, wallStart, virtStart);
+        return completed;
+    }
+
+    template <typename TDoneFunc>
+    bool runUntil(TDoneFunc&& done)
+    {
+        auto timeLimit = m_now + PhaseTimeLimitMs;
+        while (true) {
+            processReady();
+            if (done()) {
+                return true;
+            }
+
+            if (0U < m_failures) {
+                return false;
+            }
+
+            if (m_events.empty()) {
+                std::cerr << "ERROR: No more events to process" << std::endl;
+                return false;
+            }
+
+            std::pop_heap(m_events.begin(), m_events.end(), EventLater());
+            auto event = std::move(m_events.back());
+            m_events.pop_back();
+
+            if (timeLimit < event.m_time) {
+                std::cerr << "ERROR: Phase timeout" << std::endl;
+                return false;
+            }
+
+            m_now = event.m_time;
+            ++m_eventsCount;
+            dispatch(event);
+        }
+    }
+
+    void dispatch(const Event& event)
+    {
+        auto& node = m_nodes[event.m_node];
+        switch (event.m_type) {
+            case EventType_ToClient:
+                cc_mqttsn_client_process_data(
+                    node.m_client,
+                    event.m_data.data(),
+                    static_cast<unsigned>(event.m_data.size()),
+                    CC_MqttsnDataOrigin_ConnectedGw);
+                break;
+
+            case EventType_ToSessionFromClient:
+                node.m_session->dataFromClient(event.m_data.data(), event.m_data.size());
+                break;
+
+            case EventType_ToSessionFromBroker:
+                node.m_session->dataFromBroker(event.m_data.data(), event.m_data.size());
+                break;
+
+            case EventType_ToBroker:
+                brokerData(node, event.m_data);
+                break;
+
+            case EventType_ClientTimer:
+                if (event.m_timerGen == node.m_clientTimerGen) {
+                    cc_mqttsn_client_tick(node.m_client, 0U);
+                }
+                break;
+
+            case EventType_SessionTimer:
+                if (event.m_timerGen == node.m_sessionTimerGen) {
+                    ++node.m_sessionTimerGen;
+                    node.m_session->tick();
+                }
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    void pushEvent(Event&& event)
+    {
+        event.m_seq = m_nextSeq++;
+        m_events.push_back(std::move(event));
+        std::push_heap(m_events.begin(), m_events.end(), EventLater());
+    }
+
+    void pushData(EventType type, unsigned nodeIdx, const std::uint8_t* buf, std::size_t bufLen)
+    {
+        Event event;
+        event.m_time = m_now + LinkDelayMs;
+        event.m_node = nodeIdx;
+        event.m_type = type;
+        event.m_data.assign(buf, buf + bufLen);
+        pushEvent(std::move(event));
+    }
+
+    void pushTimer(EventType type, unsigned nodeIdx, unsigned gen, unsigned duration)
+    {
+        Event event;
+        event.m_time = m_now + duration;
+        event.m_node = nodeIdx;
+        event.m_timerGen = gen;
+        event.m_type = type;
+        pushEvent(std::move(event));
+    }
+
+    void reportFailure(unsigned nodeIdx, const char* msg)
+    {
+        ++m_failures;
+        if (m_failures <= MaxReportedFailures) {
+            std::cerr << "ERROR: " << msg << " (client " << nodeIdx << ")" << std::endl;
+        }
+    }
+
+    void opComplete(Node& node, bool success, const char* failureMsg)
+    {
+        if (!success) {
+            reportFailure(node.m_idx, failureMsg);
+            return;
+        }
+
+        m_latencies.push_back(microsecondsSince(node.m_opTimestamp));
+        --m_pending;
+    }
+
+    void publishNext(Node& node)
+    {
+        while ((node.m_nextPub < m_params.m_messages) && (node.m_inFlight < m_params.m_window)) {
+            auto seq = node.m_nextPub;
+            writeUint32(&m_payload[0], node.m_idx);
+            writeUint32(&m_payload[4], seq);
+
+            CC_MqttsnPublishConfig config;
+            cc_mqttsn_client_publish_init_config(&config);
+            config.m_topic = node.m_topic.c_str();
+            config.m_data = m_payload.data();
+            config.m_dataLen = static_cast<unsigned>(m_payload.size());
+            config.m_qos = m_params.m_qos;
+
+            node.m_pubTimestamps[seq] = WallClock::now();
+            ++node.m_nextPub;
+            ++node.m_inFlight;
+            auto ec = cc_mqttsn_client_publish(node.m_client, &config, &LoadBench::publishCompleteCb, &node);
+            if (ec != CC_MqttsnErrorCode_Success) {
+                --node.m_inFlight;
+                reportFailure(node.m_idx, "Failed to initiate publish");
+                return;
+            }
+        }
+    }
+
+    void publishComplete(Node& node, bool success)
+    {
+        --node.m_inFlight;
+        if (!success) {
+            reportFailure(node.m_idx, "Publish failed");
+            return;
+        }
+
+        // Issuing new publish is postponed until the client exits the current API call
+        if (!node.m_ready) {
+            node.m_ready = true;
+            m_ready.push_back(node.m_idx);
+        }
+    }
+
+    void processReady()
+    {
+        while (!m_ready.empty()) {
+            ReadyList ready;
+            ready.swap(m_ready);
+            for (auto idx : ready) {
+                auto& node = m_nodes[idx];
+                node.m_ready = false;
+                publishNext(node);
+            }
+        }
+    }
+
+    void messageReceived(Node& node, const CC_MqttsnMessageInfo& info)
+    {
+        if ((info.m_data == nullptr) || (info.m_dataLen < PayloadHeaderLen)) {
+            reportFailure(node.m_idx, "Unexpected message received");
+            return;
+        }
+
+        auto nodeIdx = readUint32(info.m_data);
+        auto seq = readUint32(info.m_data + 4U);
+        if ((nodeIdx != node.m_idx) || (m_params.m_messages <= seq)) {
+            reportFailure(node.m_idx, "Unexpected message payload");
+            return;
+        }
+
+        m_latencies.push_back(microsecondsSince(node.m_pubTimestamps[seq]));
+        ++m_received;
+    }
+
+    void brokerData(Node& node, const DataBuf& data)
+    {
+        std::size_t pos = 0U;
+        while (pos < data.size()) {
+            auto header = data[pos];
+            std::size_t remLen = 0U;
+            unsigned shift = 0U;
+            auto lenPos = pos + 1U;
+            while (true) {
+                if ((data.size() <= lenPos) || (21U < shift)) {
+                    reportFailure(node.m_idx, "Malformed MQTT frame");
+                    return;
+                }
+
+                auto byte = data[lenPos];
+                ++lenPos;
+                remLen |= static_cast<std::size_t>(byte & 0x7fU) << shift;
+                if ((byte & 0x80U) == 0U) {
+                    break;
+                }
+                shift += 7U;
+            }
+
+            if ((data.size() - lenPos) < remLen) {
+                reportFailure(node.m_idx, "Truncated MQTT frame");
+                return;
+            }
+
+            brokerMessage(node, header, &data[lenPos], remLen);
+            pos = lenPos + remLen;
+        }
+    }
+
+    void brokerMessage(Node& node, std::uint8_t header, const std::uint8_t* body, std::size_t len)
+    {
+        enum MqttType : unsigned
+        {
+            MqttType_Connect = 1,
+            MqttType_Publish = 3,
+            MqttType_Pubrec = 5,
+            MqttType_Pubrel = 6,
+            MqttType_Subscribe = 8,
+            MqttType_Unsubscribe = 10,
+            MqttType_Pingreq = 12,
+        };
+
+        auto type = static_cast<unsigned>(header >> 4U);
+        switch (type) {
+            case MqttType_Connect:
+                brokerSend(node, DataBuf{0x20, 0x02, 0x00, 0x00}); // CONNACK
+                break;
+
+            case MqttType_Publish:
+                brokerPublish(node, header, body, len);
+                break;
+
+            case MqttType_Pubrec:
+                if (2U <= len) {
+                    brokerSend(node, DataBuf{0x62, 0x02, body[0], body[1]}); // PUBREL
+                }
+                break;
+
+            case MqttType_Pubrel:
+                if (2U <= len) {
+                    brokerSend(node, DataBuf{0x70, 0x02, body[0], body[1]}); // PUBCOMP
+                }
+                break;
+
+            case MqttType_Subscribe:
+                brokerSubscribe(node, body, len);
+                break;
+
+            case MqttType_Unsubscribe:
+                if (2U <= len) {
+                    brokerSend(node, DataBuf{0xb0, 0x02, body[0], body[1]}); // UNSUBACK
+                }
+                break;
+
+            case MqttType_Pingreq:
+                brokerSend(node, DataBuf{0xd0, 0x00}); // PINGRESP
+                break;
+
+            default:
+                // PUBACK, PUBCOMP and DISCONNECT are ignored
+                break;
+        }
+    }
+
+    void brokerPublish(Node& node, std::uint8_t header, const std::uint8_t* body, std::size_t len)
+    {
+        auto qos = static_cast<std::uint8_t>((header >> 1U) & 0x3U);
+        if (len < 2U) {
+            reportFailure(node.m_idx, "Malformed PUBLISH");
+            return;
+        }
+
+        auto topicLen = readUint16(body);
+        std::size_t pos = 2U + topicLen;
+        std::size_t packetIdLen = (0U < qos) ? 2U : 0U;
+        if (len < (pos + packetIdLen)) {
+            reportFailure(node.m_idx, "Malformed PUBLISH");
+            return;
+        }
+
+        std::string topic(reinterpret_cast<const char*>(body + 2U), topicLen);
+        if (qos == 1U) {
+            brokerSend(node, DataBuf{0x40, 0x02, body[pos], body[pos + 1U]}); // PUBACK
+        }
+        else if (qos == 2U) {
+            brokerSend(node, DataBuf{0x50, 0x02, body[pos], body[pos + 1U]}); // PUBREC
+        }
+
+        pos += packetIdLen;
+
+        auto subIter =
+            std::find_if(
+                node.m_brokerSubs.begin(), node.m_brokerSubs.end(),
+                [&topic](auto& sub)
+                {
+                    return sub.first == topic;
+                });
+
+        if (subIter == node.m_brokerSubs.end()) {
+            return;
+        }
+
+        // Reflect the message back to the sender
+        auto outQos = std::min(qos, subIter->second);
+        auto payloadLen = len - pos;
+        auto outRemLen = 2U + topic.size() + payloadLen;
+        if (0U < outQos) {
+            outRemLen += 2U;
+        }
+
+        DataBuf out;
+        out.reserve(outRemLen + 5U);
+        out.push_back(static_cast<std::uint8_t>(0x30U | (outQos << 1U)));
+        appendRemLength(out, outRemLen);
+        appendUint16(out, static_cast<std::uint16_t>(topic.size()));
+        out.insert(out.end(), topic.begin(), topic.end());
+        if (0U < outQos) {
+            ++node.m_brokerPacketId;
+            if (node.m_brokerPacketId == 0U) {
+                node.m_brokerPacketId = 1U;
+            }
+            appendUint16(out, node.m_brokerPacketId);
+        }
+        out.insert(out.end(), body + pos, body + len);
+        brokerSend(node, out);
+    }
+
+    void brokerSubscribe(Node& node, const std::uint8_t* body, std::size_t len)
+    {
+        if (len < 2U) {
+            reportFailure(node.m_idx, "Malformed SUBSCRIBE");
+            return;
+        }
+
+        DataBuf codes;
+        std::size_t pos = 2U;
+        while ((pos + 2U) < len) {
+            auto topicLen = readUint16(body + pos);
+            pos += 2U;
+            if (len < (pos + topicLen + 1U)) {
+                break;
+            }
+
+            std::string topic(reinterpret_cast<const char*>(body + pos), topicLen);
+            pos += topicLen;
+            auto qos = static_cast<std::uint8_t>(std::min<unsigned>(body[pos], 2U));
+            ++pos;
+            node.m_brokerSubs.emplace_back(std::move(topic), qos);
+            codes.push_back(qos);
+        }
+
+        DataBuf out;
+        out.push_back(0x90); // SUBACK
+        appendRemLength(out, 2U + codes.size());
+        out.push_back(body[0]);
+        out.push_back(body[1]);
+        out.insert(out.end(), codes.begin(), codes.end());
+        brokerSend(node, out);
+    }
+
+    void brokerSend(Node& node, const DataBuf& data)
+    {
+        pushData(EventType_ToSessionFromBroker, node.m_idx, data.data(), data.size());
+    }
+
+    static double microsecondsSince(WallClock::time_point timestamp)
+    {
+        auto diff = std::chrono::duration_cast<std::chrono::nanoseconds>(WallClock::now() - timestamp).count();
+        return static_cast<double>(diff) / 1000.0;
+    }
+
+    void report(const char* name, std::size_t count, WallClock::time_point wallStart, std::uint64_t virtStart)
+    {
+        auto wallUs = microsecondsSince(wallStart);
+        auto rate = (0.0 < wallUs) ? ((static_cast<double>(count) * 1000000.0) / wallUs) : 0.0;
+        std::cout <<
+            std::left << std::setw(20) << name <<
+            std::right << std::setw(10) << count << " ops" <<
+            std::fixed << std::setprecision(1) <<
+            std::setw(12) << (wallUs / 1000.0) << " ms" <<
+            std::setw(12) << rate << " ops/s" <<
+            "   p50: " << percentile(m_latencies, 50U) << " us" <<
+            "   p99: " << percentile(m_latencies, 99U) << " us" <<
+            "   virtual: " << (m_now - virtStart) << " ms" << std::endl;
+    }
+
+    static const unsigned MaxReportedFailures = 10U;
+
+    const Params m_params;
+    NodesList m_nodes;
+    EventsList m_events;
+    ReadyList m_ready;
+    LatenciesList m_latencies;
+    DataBuf m_payload;
+    std::uint64_t m_now = 0U;
+    std::uint64_t m_nextSeq = 0U;
+    std::uint64_t m_eventsCount = 0U;
+    unsigned m_pending = 0U;
+    unsigned m_received = 0U;
+    unsigned m_failures = 0U;
+};
+
+} // namespace
+
+int main(int argc, const char* argv[])
+{
+    Params params;
+    auto argValue =
+        [argc, argv](int idx, unsigned defaultValue)
+        {
+            if (argc <= idx) {
+                return defaultValue;
+            }
+
+            return static_cast<unsigned>(std::strtoul(argv[idx], nullptr, 10));
+        };
+
+    params.m_clients = std::max(argValue(1, params.m_clients), 1U);
+    params.m_messages = argValue(2, params.m_messages);
+    params.m_qos = static_cast<CC_MqttsnQoS>(std::min(argValue(3, params.m_qos), static_cast<unsigned>(CC_MqttsnQoS_ExactlyOnceDelivery)));
+    params.m_payloadLen = argValue(4, params.m_payloadLen);
+    params.m_window = std::max(argValue(5, params.m_window), 1U);
+
+    LoadBench bench(params);
+    if (!bench.run()) {
+        return -1;
+    }
+
+    return 0;
+}
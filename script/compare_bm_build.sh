@@ -0,0 +1,82 @@
+#!/bin/bash
+
+# Compares the code size and the hot paths benchmark results of the bare-metal
+# ("bm") client variant between the provided git revision and the working tree.
+#
+# Usage: compare_bm_build.sh <baseline_revision>
+#
+# Input
+# CC - Main C compiler
+# CXX - Main C++ compiler
+# COMMON_BUILD_TYPE - (Optional) CMake build type, defaults to Release
+
+if [ -z "${CC}" -o -z "${CXX}" ]; then
+    echo "ERROR: Compilers are not provided"
+    exit 1
+fi
+
+if [ -z "$1" ]; then
+    echo "ERROR: Baseline revision is not provided"
+    exit 1
+fi
+
+if [ -z "${COMMON_BUILD_TYPE}" ]; then
+    COMMON_BUILD_TYPE=Release
+fi
+
+BASELINE_REV=$1
+SCRIPT_DIR="$( cd "$( dirname "${BASH_SOURCE[0]}" )" && pwd )"
+ROOT_DIR=$( dirname ${SCRIPT_DIR} )
+COMPARE_DIR="${ROOT_DIR}/build.compare_bm.${CC}.${COMMON_BUILD_TYPE}"
+BASELINE_SRC_DIR="${COMPARE_DIR}/baseline_src"
+export EXTERNALS_DIR=${ROOT_DIR}/externals
+
+procs=$(nproc)
+if [ -n "${procs}" ]; then
+    procs_param="--parallel ${procs}"
+fi
+
+set -e
+
+mkdir -p ${COMPARE_DIR}
+rm -rf ${BASELINE_SRC_DIR}
+git -C ${ROOT_DIR} worktree prune
+git -C ${ROOT_DIR} worktree add --detach ${BASELINE_SRC_DIR} ${BASELINE_REV}
+
+# Builds the bm client variant with its benchmark from the provided sources
+# and writes the code size and the benchmark output into the provided report file.
+function build_and_measure() {
+    local src_dir=$1
+    local name=$2
+    local report_file=${COMPARE_DIR}/${name}.txt
+    export BUILD_DIR=${COMPARE_DIR}/${name}
+    export COMMON_INSTALL_DIR=${BUILD_DIR}/install
+    mkdir -p ${BUILD_DIR}
+
+    ${SCRIPT_DIR}/prepare_externals.sh
+
+    cmake -S ${src_dir} -B ${BUILD_DIR} -DCMAKE_INSTALL_PREFIX=${COMMON_INSTALL_DIR} \
+        -DCMAKE_BUILD_TYPE=${COMMON_BUILD_TYPE} \
+        -DCC_MQTTSN_BUILD_UNIT_TESTS=ON \
+        -DCC_MQTTSN_CLIENT_APPS=OFF -DCC_MQTTSN_GATEWAY_LIB=OFF \
+        -DCC_MQTTSN_CUSTOM_CLIENT_CONFIG_FILES="${src_dir}/client/lib/script/BareMetalTestConfig.cmake"
+
+    cmake --build ${BUILD_DIR} --config ${COMMON_BUILD_TYPE} ${procs_param} \
+        --target cc_mqttsn_bm_client cc.mqttsn.client.bm.BenchHotPaths
+
+    local lib_file=$(find ${BUILD_DIR}/client/lib -name "libcc_mqttsn_bm_client.a" | head -n 1)
+    local bench_exe=$(find ${BUILD_DIR}/client/lib -type f -name "cc.mqttsn.client.bm.BenchHotPaths" | head -n 1)
+
+    echo "Code size of ${lib_file}:" > ${report_file}
+    size -t ${lib_file} | tail -n 1 >> ${report_file}
+    echo "" >> ${report_file}
+    ${bench_exe} >> ${report_file}
+}
+
+build_and_measure ${BASELINE_SRC_DIR} baseline
+build_and_measure ${ROOT_DIR} current
+
+git -C ${ROOT_DIR} worktree remove --force ${BASELINE_SRC_DIR}
+
+echo "Baseline (${BASELINE_REV}) vs current:"
+diff -y -W 200 ${COMPARE_DIR}/baseline.txt ${COMPARE_DIR}/current.txt || true